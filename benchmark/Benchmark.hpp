@@ -0,0 +1,105 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * @file: Benchmark.hpp
+ *
+ * Minimal benchmark harness: every workload registers itself with a name
+ * and a function, and main.cpp runs the ones asked for in the command line.
+ *
+ * @example:
+ * static void myWorkload(const bench::Options& opt) { ... }
+ * static bench::Register reg("my-workload", "what it measures", myWorkload);
+ * bench::check(tree.size() == n, "size after the load");  // exit status 1 if false
+ *
+ * */
+
+#ifndef _BENCHMARK_HPP_
+#define _BENCHMARK_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <iostream>
+
+
+/*******************************
+ * Benchmark harness
+ *******************************/
+namespace bench {
+
+/** Command line options shared by every workload */
+struct Options {
+    std::size_t size = 100000;    // number of keys in the tree
+    std::size_t repeat = 3;       // times each measurement is repeated
+    std::uint64_t seed = 2017;    // seed for the random key generators
+};
+
+/** Registered workload */
+struct Benchmark {
+    const char *name;
+    const char *description;
+    void (*run)(const Options& opt);
+};
+
+/** All registered workloads, in registration order */
+std::vector<Benchmark>& registry();
+
+/** Static registration helper, one per workload */
+struct Register {
+    Register(const char *name, const char *description, void (*run)(const Options&)) {
+        registry().push_back(Benchmark{name, description, run});
+    }
+};
+
+/** Whether a check() failed in some workload: the harness then exits with 1 */
+bool& failed();
+
+/**
+ * Sanity check of a workload on the trees it measures, reported on failure
+ * */
+inline void check(bool condition, const char *what) {
+    if (condition) return;
+    std::cerr << "check failed: " << what << std::endl;
+    failed() = true;
+}
+
+/** Monotonic clock used for every measurement */
+using Clock = std::chrono::steady_clock;
+
+/** Nanoseconds elapsed between two time points */
+inline std::uint64_t nanos(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/** Keys 0, 1, ..., n-1 in increasing order */
+inline std::vector<int> sequentialKeys(std::size_t n) {
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    return keys;
+}
+
+/** Keys 0, 1, ..., n-1 in random order */
+inline std::vector<int> shuffledKeys(std::size_t n, std::uint64_t seed) {
+    std::vector<int> keys = sequentialKeys(n);
+    std::mt19937_64 rng(seed);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+/**
+ * Prevent the compiler from optimizing away a computed value
+ * */
+template <class V>
+inline void doNotOptimize(const V& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+}  // namespace bench
+
+
+#endif  // end of include guard: _BENCHMARK_HPP_
@@ -0,0 +1,166 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * @file: LatencyHistogram.hpp
+ *
+ * HDR-style (log-linear) latency histogram: values below 2^SubBits are counted
+ * exactly and above that every power of two is split in 2^(SubBits-1) buckets,
+ * so the relative error of any reported value is under 2^-(SubBits-1).
+ * Recording is O(1) and allocation free, which makes it cheap enough to wrap
+ * every single tree operation of a workload.
+ *
+ * @example:
+ * bench::LatencyHistogram hist;
+ * for (int k : keys) hist.time([&] { avl.insert(k); });
+ * hist.print(std::cout, "insert");  // count, mean, p50, p99, p99.9, max
+ *
+ * */
+
+#ifndef _LATENCYHISTOGRAM_HPP_
+#define _LATENCYHISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include "Benchmark.hpp"
+
+
+/*******************************
+ * Benchmark harness
+ *******************************/
+namespace bench {
+
+template <unsigned SubBits = 7>
+class BasicLatencyHistogram {
+    static_assert(SubBits >= 2 && SubBits <= 16, "unreasonable histogram precision");
+    static constexpr std::uint64_t Half = std::uint64_t{1} << (SubBits - 1);
+    static constexpr std::size_t Buckets = (64 - SubBits + 2) * Half;
+
+ public:
+    /* External Methods */
+    void record(std::uint64_t value);
+    template <class F> void time(F&& operation);
+    void reset();
+    std::uint64_t count() const { return total; }
+    std::uint64_t max() const { return maxValue; }
+    std::uint64_t min() const { return total ? minValue : 0; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.0; }
+    std::uint64_t percentile(double p) const;
+    std::ostream& print(std::ostream& os, const char *label) const;
+
+ private:
+    /* Internal Methods */
+    static std::size_t indexOf(std::uint64_t value);
+    static std::uint64_t highestOf(std::size_t index);
+
+    std::array<std::uint64_t, Buckets> buckets{};
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t minValue = ~std::uint64_t{0};
+    std::uint64_t maxValue = 0;
+};
+
+/** Default precision: 128 sub-buckets, under 1.6% relative error */
+using LatencyHistogram = BasicLatencyHistogram<>;
+
+
+
+/**
+ * >> BasicLatencyHistogram implementation <<
+ * */
+
+/**
+ * Count one value (nanoseconds)
+ * */
+template <unsigned SubBits>
+void BasicLatencyHistogram<SubBits>::record(std::uint64_t value) {
+    ++buckets[indexOf(value)];
+    ++total;
+    sum += value;
+    if (value < minValue) minValue = value;
+    if (value > maxValue) maxValue = value;
+}
+
+/**
+ * Run an operation and record how long it took
+ * */
+template <unsigned SubBits>
+template <class F>
+inline void BasicLatencyHistogram<SubBits>::time(F&& operation) {
+    auto start = Clock::now();
+    operation();
+    record(nanos(start, Clock::now()));
+}
+
+/**
+ * Forget every recorded value
+ * */
+template <unsigned SubBits>
+void BasicLatencyHistogram<SubBits>::reset() {
+    buckets.fill(0);
+    total = sum = maxValue = 0;
+    minValue = ~std::uint64_t{0};
+}
+
+/**
+ * Value at or below which the given percentage (0-100) of the samples are
+ * @return the highest value equivalent to the bucket holding that sample
+ * */
+template <unsigned SubBits>
+std::uint64_t BasicLatencyHistogram<SubBits>::percentile(double p) const {
+    if (total == 0) return 0;
+    if (p >= 100.0) return maxValue;
+    auto rank = static_cast<std::uint64_t>(p / 100.0 * total + 0.5);
+    if (rank == 0) rank = 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < Buckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(highestOf(i), maxValue);
+    }
+    return maxValue;
+}
+
+/**
+ * Print a one line summary: label, count, mean, p50, p99, p99.9, max (ns)
+ * */
+template <unsigned SubBits>
+std::ostream& BasicLatencyHistogram<SubBits>::print(std::ostream& os, const char *label) const {
+    os << std::left << std::setw(24) << label << std::right
+       << std::setw(10) << count()
+       << std::setw(12) << std::fixed << std::setprecision(1) << mean()
+       << std::setw(9) << percentile(50.0)
+       << std::setw(9) << percentile(99.0)
+       << std::setw(9) << percentile(99.9)
+       << std::setw(11) << max() << '\n';
+    return os;
+}
+
+/**
+ * Bucket of a value: exact below 2^SubBits, then Half buckets per power of two
+ * */
+template <unsigned SubBits>
+inline std::size_t BasicLatencyHistogram<SubBits>::indexOf(std::uint64_t value) {
+    if (value < 2 * Half) return value;
+    unsigned shift = 63 - __builtin_clzll(value) - (SubBits - 1);
+    return shift * Half + (value >> shift);
+}
+
+/**
+ * Greatest value that falls in the given bucket
+ * */
+template <unsigned SubBits>
+inline std::uint64_t BasicLatencyHistogram<SubBits>::highestOf(std::size_t index) {
+    if (index < 2 * Half) return index;
+    std::uint64_t shift = index / Half - 1;
+    std::uint64_t mantissa = index - shift * Half;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+
+}  // namespace bench
+
+
+#endif  // end of include guard: _LATENCYHISTOGRAM_HPP_
@@ -0,0 +1,249 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * @file: PerfCounters.hpp
+ *
+ * Hardware performance counters read through Linux perf_event_open(2):
+ * cycles, instructions, L1d and last level cache misses, branch misses and
+ * dTLB misses, counted in user space only for the calling thread.
+ * Every event is opened on its own, so an event the CPU (or the VM, or
+ * kernel.perf_event_paranoid) does not allow is simply reported as "n/a"
+ * while the others keep working. On other systems nothing is counted.
+ *
+ * measure() wraps a workload with the counters and wall time and returns
+ * the per-operation figures of the fastest of a few repetitions.
+ *
+ * @example:
+ * auto m = bench::measure(opt.repeat, keys.size(), [&] { for (int k : keys) bst.get(k); });
+ * bench::printHeader(std::cout);
+ * bench::print(std::cout, "BSTree::get", m);
+ *
+ * */
+
+#ifndef _PERFCOUNTERS_HPP_
+#define _PERFCOUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include "Benchmark.hpp"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+
+/*******************************
+ * Benchmark harness
+ *******************************/
+namespace bench {
+
+class PerfCounters {
+ public:
+    /** Counted events */
+    enum eEvent {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        DTLB_MISSES,
+        EVENTS
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /* External Methods */
+    bool available() const;
+    bool available(eEvent event) const { return fds[event] >= 0; }
+    void start();
+    void stop();
+    double value(eEvent event) const { return values[event]; }
+    static const char* name(eEvent event);
+
+ private:
+    std::array<int, EVENTS> fds;
+    std::array<double, EVENTS> values{};
+};
+
+/** Wall time and counters of a workload, divided by its number of operations */
+struct Measurement {
+    double nanos = 0;
+    std::array<double, PerfCounters::EVENTS> events{};
+    std::array<bool, PerfCounters::EVENTS> counted{};
+};
+
+/** Counters shared by every workload (opened once) */
+PerfCounters& counters();
+
+template <class F> Measurement measure(std::size_t repeat, std::size_t ops, F&& workload);
+void printHeader(std::ostream& os);
+void print(std::ostream& os, const char *label, const Measurement& m);
+
+
+
+/**
+ * >> PerfCounters implementation <<
+ * */
+
+/**
+ * Open every counter, leaving the unavailable ones with fd = -1
+ * */
+inline PerfCounters::PerfCounters() {
+    fds.fill(-1);
+#ifdef __linux__
+    auto cache = [](std::uint64_t id, std::uint64_t op, std::uint64_t result) {
+        return id | (op << 8) | (result << 16);
+    };
+    const std::uint32_t types[EVENTS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+    };
+    const std::uint64_t configs[EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+        cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS),
+        PERF_COUNT_HW_BRANCH_MISSES,
+        cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)
+    };
+    for (int e = 0; e < EVENTS; ++e) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = types[e];
+        attr.config = configs[e];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds[e] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+inline PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds)
+        if (fd >= 0) close(fd);
+#endif
+}
+
+/**
+ * Whether at least one event could be opened
+ * */
+inline bool PerfCounters::available() const {
+    for (int fd : fds)
+        if (fd >= 0) return true;
+    return false;
+}
+
+/**
+ * Reset and enable every open counter
+ * */
+inline void PerfCounters::start() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/**
+ * Disable the counters and read them, scaling the ones the kernel had to multiplex
+ * */
+inline void PerfCounters::stop() {
+    values.fill(0);
+#ifdef __linux__
+    for (int fd : fds)
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    for (int e = 0; e < EVENTS; ++e) {
+        std::uint64_t data[3];  // value, time enabled, time running
+        if (fds[e] < 0 || read(fds[e], data, sizeof(data)) != sizeof(data)) continue;
+        values[e] = data[2] ? static_cast<double>(data[0]) * data[1] / data[2] : 0.0;
+    }
+#endif
+}
+
+/**
+ * Short column name of an event
+ * */
+inline const char* PerfCounters::name(eEvent event) {
+    static const char *names[EVENTS] = {
+        "cycles", "instr", "L1d-miss", "LLC-miss", "br-miss", "dTLB-miss"
+    };
+    return names[event];
+}
+
+inline PerfCounters& counters() {
+    static PerfCounters pc;
+    return pc;
+}
+
+/**
+ * Run a workload of 'ops' operations 'repeat' times under the counters
+ * @return the per-operation figures of the fastest run
+ * */
+template <class F>
+Measurement measure(std::size_t repeat, std::size_t ops, F&& workload) {
+    PerfCounters& pc = counters();
+    Measurement best;
+    if (ops == 0) ops = 1;
+    for (std::size_t r = 0; r < (repeat ? repeat : 1); ++r) {
+        pc.start();
+        auto start = Clock::now();
+        workload();
+        auto end = Clock::now();
+        pc.stop();
+        double ns = static_cast<double>(nanos(start, end)) / ops;
+        if (r > 0 && ns >= best.nanos) continue;
+        best.nanos = ns;
+        for (int e = 0; e < PerfCounters::EVENTS; ++e) {
+            auto event = static_cast<PerfCounters::eEvent>(e);
+            best.counted[e] = pc.available(event);
+            best.events[e] = pc.value(event) / ops;
+        }
+    }
+    return best;
+}
+
+/**
+ * Column titles matching print()
+ * */
+inline void printHeader(std::ostream& os) {
+    os << std::left << std::setw(32) << "per operation" << std::right << std::setw(10) << "ns";
+    for (int e = 0; e < PerfCounters::EVENTS; ++e)
+        os << std::setw(11) << PerfCounters::name(static_cast<PerfCounters::eEvent>(e));
+    os << '\n';
+}
+
+/**
+ * One row of per-operation figures, "n/a" for the events not counted
+ * */
+inline void print(std::ostream& os, const char *label, const Measurement& m) {
+    os << std::left << std::setw(32) << label << std::right
+       << std::fixed << std::setprecision(1) << std::setw(10) << m.nanos << std::setprecision(2);
+    for (int e = 0; e < PerfCounters::EVENTS; ++e) {
+        if (m.counted[e]) {
+            os << std::setw(11) << m.events[e];
+        } else {
+            os << std::setw(11) << "n/a";
+        }
+    }
+    os << '\n';
+}
+
+
+}  // namespace bench
+
+
+#endif  // end of include guard: _PERFCOUNTERS_HPP_
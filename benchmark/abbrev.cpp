@@ -0,0 +1,89 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Abbreviated keys: AVLTree<std::string>, whose nodes cache an 8-byte
+ * normalized prefix of the key (base::KeyPrefix<std::string>), against
+ * the same tree comparing the full strings only. UUID keys (random from
+ * the first byte: the prefixes decide) and URL-like keys (the first 8
+ * bytes are "https://", a tie every time). Node size, insert and get.
+ * */
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+/** std::string without the cached prefix (base::KeyPrefix is not specialized for it) */
+struct FullString : string {
+    using string::string;
+    FullString(const string& s) : string(s) {}
+    bool operator<(const FullString& o) const { return compare(o) < 0; }
+    bool operator>(const FullString& o) const { return compare(o) > 0; }
+};
+
+vector<string> uuids(std::size_t n, std::uint64_t seed) {
+    mt19937_64 rng(seed);
+    vector<string> keys;
+    char buf[40];
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint64_t a = rng(), b = rng();
+        snprintf(buf, sizeof(buf), "%08x-%04x-%04x-%04x-%012llx", unsigned(a >> 32),
+                 unsigned(a >> 16) & 0xFFFF, unsigned(a) & 0xFFFF, unsigned(b >> 48) & 0xFFFF,
+                 static_cast<unsigned long long>(b & 0xFFFFFFFFFFFFULL));
+        keys.push_back(buf);
+    }
+    return keys;
+}
+
+vector<string> urls(std::size_t n, std::uint64_t seed) {
+    static const char *hosts[] = {"www.example.com", "api.example.com", "cdn.example.net",
+                                  "docs.example.org", "shop.example.com"};
+    static const char *paths[] = {"users", "items", "static/img", "v2/orders", "search"};
+    mt19937_64 rng(seed);
+    vector<string> keys;
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(string("https://") + hosts[rng() % 5] + "/" + paths[rng() % 5] + "/"
+                       + to_string(rng() % (n * 4)));
+    }
+    return keys;
+}
+
+template <class K>
+void perTree(const string& name, const vector<string>& strings, const bench::Options& opt) {
+    vector<K> keys(strings.begin(), strings.end());
+    trees::AVLTree<K> tree;
+    auto insert = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (const K& k : keys) tree.insert(k);
+    });
+    auto get = bench::measure(opt.repeat, keys.size(), [&] {
+        for (const K& k : keys) bench::doNotOptimize(tree.get(k));
+    });
+    bench::print(cout, (name + " insert").c_str(), insert);
+    bench::print(cout, (name + " get").c_str(), get);
+}
+
+void abbrevBenchmark(const bench::Options& opt) {
+    cout << "sizeof(Node): with prefix " << sizeof(trees::AVLNode<string>)
+         << ", full strings only " << sizeof(trees::AVLNode<FullString>) << "\n";
+    bench::printHeader(cout);
+    const auto uuid = uuids(opt.size, opt.seed);
+    perTree<string>("uuid prefix", uuid, opt);
+    perTree<FullString>("uuid full", uuid, opt);
+    const auto url = urls(opt.size, opt.seed);
+    perTree<string>("url prefix", url, opt);
+    perTree<FullString>("url full", url, opt);
+}
+
+bench::Register reg("abbrev", "string trees with the cached 8-byte key prefix against full comparisons",
+                    abbrevBenchmark);
+
+}  // namespace
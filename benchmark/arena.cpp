@@ -0,0 +1,122 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * String keys: AVLTree<std::string> (a node, plus the string's own buffer
+ * past the small string size) against StringAVLTree (a node, the bytes
+ * bump-allocated in the tree's arena). Allocations and heap bytes per key
+ * (malloc, glibc only), insert and get of 22-51 byte keys.
+ * Run with -n 10000000 for ten million keys.
+ * */
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLTree.hpp"
+#include "StringAVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/** Bytes currently allocated by malloc, 0 where unknown */
+std::size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+/** "user:<16 hex digits>/" and a 0-29 byte tail */
+vector<string> makeKeys(std::size_t n, std::uint64_t seed) {
+    mt19937_64 rng(seed);
+    vector<string> keys;
+    keys.reserve(n);
+    char buf[32];
+    for (std::size_t i = 0; i < n; ++i) {
+        snprintf(buf, sizeof(buf), "user:%016llx/", static_cast<unsigned long long>(rng()));
+        keys.push_back(string(buf) + string(rng() % 30, 'a' + static_cast<char>(i % 26)));
+    }
+    return keys;
+}
+
+void printMemory(const string& name, std::size_t allocations, std::size_t heap, std::size_t n) {
+    cout << name << ": " << static_cast<double>(allocations) / n << " allocations per key, "
+         << (heap ? to_string(heap / n) : string("n/a")) << " heap bytes per key\n";
+}
+
+void arenaBenchmark(const bench::Options& opt) {
+    const auto keys = makeKeys(opt.size, opt.seed);
+    const std::size_t inlineChars = string().capacity();  // small string size
+
+    std::size_t heap = heapInUse();
+    trees::AVLTree<string> strings;
+    for (const string& k : keys) strings.insert(k);
+    heap = heapInUse() - heap;
+    std::size_t allocations = strings.size();
+    for (const string& k : strings) allocations += k.size() > inlineChars;
+    printMemory("AVLTree<string>", allocations, heap, keys.size());
+
+    heap = heapInUse();
+    trees::StringAVLTree views;
+    for (const string& k : keys) views.insert(k);
+    heap = heapInUse() - heap;
+    allocations = views.size() + views.arenaBytes() / trees::base::StringArena::CHUNK;
+    printMemory("StringAVLTree", allocations, heap, keys.size());
+
+    bench::printHeader(cout);
+    auto insertStrings = bench::measure(opt.repeat, keys.size(), [&] {
+        strings.clear();
+        for (const string& k : keys) strings.insert(k);
+    });
+    auto getStrings = bench::measure(opt.repeat, keys.size(), [&] {
+        for (const string& k : keys) bench::doNotOptimize(strings.get(k));
+    });
+    strings.clear();
+    auto insertViews = bench::measure(opt.repeat, keys.size(), [&] {
+        views.clear();
+        for (const string& k : keys) views.insert(k);
+    });
+    auto getViews = bench::measure(opt.repeat, keys.size(), [&] {
+        for (const string& k : keys) bench::doNotOptimize(views.get(k));
+    });
+
+    {  // a moved-from tree is empty and takes new keys in its own arena
+        trees::StringAVLTree from;
+        from.insert("moved key");
+        auto moved = std::make_unique<trees::StringAVLTree>(std::move(from));
+        bench::check(from.isEmpty() && from.keyBytes() == 0 && from.arenaBytes() == 0,
+                     "StringAVLTree moved-from is empty");
+        from.insert("after the move");
+        moved->insert("another key");
+        moved.reset();
+        bench::check(from.get("after the move") && !from.get("moved key") && from.size() == 1,
+                     "StringAVLTree moved-from keeps its own keys");
+        trees::StringAVLTree to;
+        to.insert("replaced");
+        to = std::move(from);
+        from.insert("again");
+        bench::check(to.get("after the move") && !to.get("replaced") && from.size() == 1,
+                     "StringAVLTree move assignment");
+    }
+
+    bench::print(cout, "AVLTree<string> insert", insertStrings);
+    bench::print(cout, "AVLTree<string> get", getStrings);
+    bench::print(cout, "StringAVLTree insert", insertViews);
+    bench::print(cout, "StringAVLTree get", getViews);
+}
+
+bench::Register reg("arena", "AVLTree<std::string> against StringAVLTree (keys in a bump arena)",
+                    arenaBenchmark);
+
+}  // namespace
@@ -0,0 +1,54 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Interleaved batched lookups (getBatch) against a loop of get(),
+ * for growing batch sizes. Like any latency hiding technique, the
+ * gain shows when the tree is larger than the cache (big -n).
+ * */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+template <class Tree>
+void perTree(const char *name, const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    const auto probes = bench::shuffledKeys(opt.size, opt.seed + 1);
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+
+    auto loop = bench::measure(opt.repeat, probes.size(), [&] {
+        for (int k : probes) bench::doNotOptimize(tree.get(k));
+    });
+    bench::print(cout, (string(name) + " get loop").c_str(), loop);
+
+    vector<int*> out(probes.size());
+    for (std::size_t batch : {1, 2, 4, 8, 16, 32, 64, 256}) {
+        auto batched = bench::measure(opt.repeat, probes.size(), [&] {
+            for (std::size_t i = 0; i < probes.size(); i += batch) {
+                std::size_t count = probes.size() - i < batch ? probes.size() - i : batch;
+                tree.getBatch(&probes[i], count, &out[i]);
+            }
+            bench::doNotOptimize(out.data());
+        });
+        bench::print(cout, (string(name) + " getBatch " + to_string(batch)).c_str(), batched);
+    }
+}
+
+void batchBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree", opt);
+    perTree<trees::AVLTree<int>>("AVLTree", opt);
+}
+
+bench::Register reg("batch", "getBatch by batch size against a loop of get()", batchBenchmark);
+
+}  // namespace
@@ -0,0 +1,118 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * AVLTree<int> (one key per node) against BucketAVLTree<int, K> (up to K
+ * sorted keys per node) for K = 8, 16, 32: nodes and bytes per key, as
+ * node size times nodes and as seen by malloc (glibc only), and random
+ * insert, get, in-order scan and remove throughput, and the keys per node
+ * left by removals at random, in order and from one end.
+ * */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "BucketAVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/** Bytes currently allocated by malloc, 0 where unknown */
+std::size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+template <class Tree> std::size_t nodesOf(const Tree& tree) { return tree.size(); }
+template <class T, std::size_t K>
+std::size_t nodesOf(const trees::BucketAVLTree<T, K>& tree) { return tree.nodes(); }
+
+template <class Tree>
+void perTree(const string& name, const vector<int>& keys, const bench::Options& opt) {
+    Tree tree;
+    std::size_t heap = heapInUse();
+    for (int k : keys) tree.insert(k);
+    heap = heapInUse() - heap;
+    const std::size_t nodes = nodesOf(tree);
+    cout << name << ": " << nodes << " nodes of " << sizeof(typename Tree::Node) << " bytes, "
+         << sizeof(typename Tree::Node) * nodes / keys.size() << " bytes per key, heap per key = "
+         << (heap ? to_string(heap / keys.size()) : string("n/a")) << " bytes\n";
+
+    auto insert = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (int k : keys) tree.insert(k);
+    });
+    auto get = bench::measure(opt.repeat, keys.size(), [&] {
+        for (int k : keys) bench::doNotOptimize(tree.get(k));
+    });
+    auto scan = bench::measure(opt.repeat, keys.size(), [&] {
+        long sum = 0;
+        for (int k : tree) sum += k;
+        bench::doNotOptimize(sum);
+    });
+    auto remove = bench::measure(1, keys.size(), [&] {
+        for (int k : keys) tree.remove(k);
+    });
+
+    bench::print(cout, (name + " insert random").c_str(), insert);
+    bench::print(cout, (name + " get").c_str(), get);
+    bench::print(cout, (name + " scan").c_str(), scan);
+    bench::print(cout, (name + " remove random").c_str(), remove);
+}
+
+/**
+ * Keys per node left by removals, that refill or merge the nodes they leave
+ * under MIN_FILL: 9 in 10 keys removed at random, 9 in 10 in order (all
+ * but the multiples of 10) and 3/4 drained from the least end.
+ * */
+template <std::size_t K>
+void fill(const vector<int>& keys) {
+    using Tree = trees::BucketAVLTree<int, K>;
+    auto report = [](const Tree& tree, const char *removal) {
+        const double fill = tree.nodes() ? static_cast<double>(tree.size()) / tree.nodes() : K;
+        cout << "Bucket<" << K << "> " << removal << ": " << fill << " keys per node\n";
+        bench::check(tree.nodes() < 16 || fill >= Tree::MIN_FILL,
+                     "BucketAVLTree nodes stay half full on average after removals");
+    };
+    Tree random, strided, drained;
+    for (int k : keys) {
+        random.insert(k);
+        strided.insert(k);
+        drained.insert(k);
+    }
+    for (std::size_t i = 0; i < keys.size() / 10 * 9; ++i) random.remove(keys[i]);
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        if (k % 10 != 0) strided.remove(static_cast<int>(k));
+    }
+    for (std::size_t i = 0; i < keys.size() * 3 / 4; ++i) drained.removeMin();
+    report(random, "after 9/10 removed at random");
+    report(strided, "after 9/10 removed in order");
+    report(drained, "drained 3/4 by removeMin()");
+}
+
+void bucketBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    bench::printHeader(cout);
+    perTree<trees::AVLTree<int>>("AVL", keys, opt);
+    perTree<trees::BucketAVLTree<int, 8>>("Bucket<8>", keys, opt);
+    perTree<trees::BucketAVLTree<int, 16>>("Bucket<16>", keys, opt);
+    perTree<trees::BucketAVLTree<int, 32>>("Bucket<32>", keys, opt);
+    fill<8>(keys);
+    fill<16>(keys);
+    fill<32>(keys);
+}
+
+bench::Register reg("bucket", "bytes per key, get, scan of AVLTree against BucketAVLTree (K keys per node)",
+                    bucketBenchmark);
+
+}  // namespace
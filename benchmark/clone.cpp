@@ -0,0 +1,75 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Copying an AVLTree: by reinserting every key into a new tree, by clone()
+ * (one pass, same shape) with 1 to 8 threads, and moving it. Times are per
+ * element, the copies freed untimed.
+ * */
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Tree = trees::AVLTree<int>;
+
+/**
+ * Best time of a copy of tree made by workload, per element
+ * */
+template <class F>
+bench::Measurement copy(const Tree& tree, const bench::Options& opt, F&& workload) {
+    bench::Measurement best;
+    for (std::size_t r = 0; r < opt.repeat; ++r) {
+        unique_ptr<Tree> copied;
+        auto m = bench::measure(1, tree.size(), [&] { copied = workload(); });
+        if (r == 0 || m.nanos < best.nanos) best = m;
+    }
+    return best;
+}
+
+void cloneBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+
+    cout << "hardware threads: " << thread::hardware_concurrency() << '\n';
+    bench::printHeader(cout);
+    auto reinsert = copy(tree, opt, [&] {
+        auto copied = make_unique<Tree>();
+        for (int k : tree) copied->insert(k);
+        return copied;
+    });
+    bench::print(cout, "reinsert", reinsert);
+    for (unsigned threads : {1, 2, 4, 8}) {
+        auto clone = copy(tree, opt, [&] { return make_unique<Tree>(tree.clone(threads)); });
+        bench::print(cout, ("clone(" + to_string(threads) + ")").c_str(), clone);
+    }
+    tree.setPrefetch(trees::PREFETCH_CHILDREN);
+    tree.setAutoRebalance(2.0);
+    auto move = copy(tree, opt, [&] {
+        auto moved = make_unique<Tree>(std::move(tree));
+        tree = std::move(*moved);
+        return moved;
+    });
+    bench::print(cout, "move there and back", move);
+    {  // fresh trees, as the moved-from one keeps its own settings
+        Tree moved(std::move(tree));
+        Tree assigned;
+        assigned = std::move(moved);
+        bench::check(assigned.size() == keys.size()
+                     && assigned.getPrefetch() == trees::PREFETCH_CHILDREN
+                     && assigned.getAutoRebalance() == 2.0, "moving keeps the nodes and settings");
+    }
+}
+
+bench::Register reg("clone", "AVLTree clone() with 1-8 threads against copying by reinsertion",
+                    cloneBenchmark);
+
+}  // namespace
@@ -0,0 +1,93 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Lookup tables known at compile time: the C++ keywords and a set of 128
+ * opcodes, built at startup into an AVLTree against a constexpr
+ * ConstexprTree (Eytzinger layout, built by the compiler). Startup cost
+ * per table and get throughput over -n random tokens, half of them misses.
+ * */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLTree.hpp"
+#include "ConstexprTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+constexpr string_view KEYWORDS[] = {
+    "alignas", "alignof", "and", "asm", "auto", "bitand", "bitor", "bool", "break", "case",
+    "catch", "char", "class", "compl", "const", "constexpr", "const_cast", "continue",
+    "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+    "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+    "int", "long", "mutable", "namespace", "new", "noexcept", "not", "nullptr", "operator",
+    "or", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+    "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+    "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid",
+    "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t",
+    "while", "xor"};
+
+constexpr auto keywords = trees::makeConstexprTree(KEYWORDS);
+static_assert(keywords.contains("constexpr") && !keywords.contains("constexp"),
+              "built by the compiler");
+
+/** 128 opcodes: the odd multiples of 3 */
+constexpr auto opcodes = [] {
+    int codes[128] = {};
+    for (int i = 0; i < 128; ++i) codes[i] = 3 * (2 * i + 1);
+    return trees::makeConstexprTree(codes);
+}();
+
+template <class Key, class Table, class Build>
+void perTable(const string& name, const vector<Key>& probes, const Table& table,
+              Build&& build, const bench::Options& opt) {
+    auto startup = bench::measure(opt.repeat, 1, [&] { bench::doNotOptimize(build().isEmpty()); });
+    auto tree = build();
+    auto get = bench::measure(opt.repeat, probes.size(), [&] {
+        for (const Key& k : probes) bench::doNotOptimize(tree.get(k));
+    });
+    auto getConst = bench::measure(opt.repeat, probes.size(), [&] {
+        for (const Key& k : probes) bench::doNotOptimize(table.get(k));
+    });
+    bench::print(cout, (name + " AVLTree build").c_str(), startup);
+    bench::print(cout, (name + " AVLTree get").c_str(), get);
+    bench::print(cout, (name + " ConstexprTree get").c_str(), getConst);
+}
+
+void constexprBenchmark(const bench::Options& opt) {
+    mt19937_64 rng(opt.seed);
+    vector<string> words;
+    vector<int> codes;
+    for (std::size_t i = 0; i < opt.size; ++i) {
+        string word(KEYWORDS[rng() % size(KEYWORDS)]);
+        if (rng() % 2) word.back() = '_';  // miss
+        words.push_back(word);
+        codes.push_back(static_cast<int>(rng() % 768));
+    }
+    vector<string_view> views(words.begin(), words.end());
+
+    cout << "sizeof(keywords) = " << sizeof(keywords) << ", sizeof(opcodes) = " << sizeof(opcodes)
+         << " (static data, no heap)\n";
+    bench::printHeader(cout);
+    perTable("keywords", views, keywords, [] {
+        trees::AVLTree<string_view> tree;
+        for (string_view k : KEYWORDS) tree.insert(k);
+        return tree;
+    }, opt);
+    perTable("opcodes", codes, opcodes, [] {
+        trees::AVLTree<int> tree;
+        for (int k : opcodes) tree.insert(k);
+        return tree;
+    }, opt);
+}
+
+bench::Register reg("constexpr", "startup and get of AVLTree lookup tables against constexpr ConstexprTree",
+                    constexprBenchmark);
+
+}  // namespace
@@ -0,0 +1,93 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Load with BSTree, serve with AVLTree: the unbalanced load against an AVL
+ * load, then turning the loaded BSTree<int, AVLNode> into an AVLTree by
+ * relinking its nodes (no allocation), from a BSTree<int> of another node
+ * layout (one new node per key), and by reinserting every key. Times are per
+ * key, each conversion on a freshly loaded tree.
+ * */
+
+#include <iostream>
+#include <memory>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Load = trees::BSTree<int, trees::AVLNode>;
+using Serve = trees::AVLTree<int>;
+
+/**
+ * Best time of a conversion of a new tree of type From loaded with keys, per
+ * key. The converted tree is returned by the workload, to free it untimed.
+ * */
+template <class From, class F>
+bench::Measurement convert(const vector<int>& keys, const bench::Options& opt, F&& workload) {
+    bench::Measurement best;
+    for (std::size_t r = 0; r < opt.repeat; ++r) {
+        From tree;
+        for (int k : keys) tree.insert(k);
+        decltype(workload(tree)) converted;
+        auto m = bench::measure(1, keys.size(), [&] { converted = workload(tree); });
+        if (r == 0 || m.nanos < best.nanos) best = m;
+    }
+    return best;
+}
+
+void convertBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+
+    bench::printHeader(cout);
+    auto load = bench::measure(opt.repeat, keys.size(), [&] {
+        Load tree;
+        for (int k : keys) tree.insert(k);
+    });
+    auto loadAVL = bench::measure(opt.repeat, keys.size(), [&] {
+        Serve tree;
+        for (int k : keys) tree.insert(k);
+    });
+    auto relink = convert<Load>(keys, opt, [](Load& t) {
+        return make_unique<Serve>(std::move(t));
+    });
+    auto layout = convert<trees::BSTree<int>>(keys, opt, [](trees::BSTree<int>& t) {
+        return make_unique<Serve>(std::move(t));
+    });
+    auto reinsert = convert<Load>(keys, opt, [](Load& t) {
+        auto serve = make_unique<Serve>();
+        for (int k : t) serve->insert(k);
+        t.clear();
+        return serve;
+    });
+    auto back = convert<Serve>(keys, opt, [](Serve& t) {
+        return make_unique<Load>(std::move(t));
+    });
+
+    {  // the settings come along, whatever the node layouts
+        trees::BSTree<int> from;
+        for (int k : keys) from.insert(k);
+        from.setPrefetch(trees::PREFETCH_CHILDREN);
+        from.setAutoRebalance(2.0);
+        Serve served(std::move(from));
+        Load loaded(std::move(served));
+        trees::BSTree<int> to(std::move(loaded));
+        bench::check(to.size() == keys.size() && to.getPrefetch() == trees::PREFETCH_CHILDREN
+                     && to.getAutoRebalance() == 2.0, "converting keeps the nodes and settings");
+    }
+
+    bench::print(cout, "load BSTree<int, AVLNode>", load);
+    bench::print(cout, "load AVLTree<int>", loadAVL);
+    bench::print(cout, "AVLTree(BSTree&&) relink", relink);
+    bench::print(cout, "AVLTree(BSTree<int>&&)", layout);
+    bench::print(cout, "reinsert into AVLTree", reinsert);
+    bench::print(cout, "BSTree(AVLTree&&) back", back);
+}
+
+bench::Register reg("convert", "BSTree to AVLTree by relinking the nodes against reinsertion",
+                    convertBenchmark);
+
+}  // namespace
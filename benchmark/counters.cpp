@@ -0,0 +1,58 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Hardware counters per operation (cycles, instructions, cache/TLB/branch
+ * misses) of insert and get, for each tree type at growing tree sizes,
+ * from 1000 keys up to the -n size in steps of x10.
+ * */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+/**
+ * Insert and get of random keys on a tree of each size
+ * */
+template <class Tree>
+void perTree(const char *name, const bench::Options& opt) {
+    for (std::size_t n = 1000; ; n *= 10) {
+        if (n > opt.size) n = opt.size;
+        const auto keys = bench::shuffledKeys(n, opt.seed);
+        const auto probes = bench::shuffledKeys(n, opt.seed + 1);
+        Tree tree;
+
+        auto insert = bench::measure(opt.repeat, n, [&] {
+            tree.clear();
+            for (int k : keys) tree.insert(k);
+        });
+        auto get = bench::measure(opt.repeat, n, [&] {
+            for (int k : probes) bench::doNotOptimize(tree.get(k));
+        });
+
+        string label = string(name) + " n=" + to_string(n);
+        bench::print(cout, (label + " insert").c_str(), insert);
+        bench::print(cout, (label + " get").c_str(), get);
+        if (n == opt.size) break;
+    }
+}
+
+void countersBenchmark(const bench::Options& opt) {
+    if (!bench::counters().available())
+        cout << "(hardware counters unavailable: check perf_event_paranoid or the VM PMU)\n";
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree", opt);
+    perTree<trees::AVLTree<int>>("AVLTree", opt);
+}
+
+bench::Register reg("counters", "cycles/instructions/cache, branch and TLB misses per operation",
+                    countersBenchmark);
+
+}  // namespace
@@ -0,0 +1,74 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Expiring a part of a time-indexed AVLTree: eraseBefore() against a loop
+ * of removeMin(), eraseAfter() against removeMax() and eraseRange() against
+ * remove() of every key in the range, for a growing share of the keys.
+ * Times are per element removed, each on a freshly built tree.
+ * */
+
+#include <iostream>
+#include <string>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Tree = trees::AVLTree<int>;
+
+/**
+ * Best time of an erase over a new tree, per element removed
+ * */
+template <class F>
+bench::Measurement erase(const vector<int>& keys, std::size_t removed, const bench::Options& opt,
+                         F&& workload) {
+    bench::Measurement best;
+    for (std::size_t r = 0; r < opt.repeat; ++r) {
+        Tree tree;
+        for (int k : keys) tree.insert(k);
+        auto m = bench::measure(1, removed, [&] { workload(tree); });
+        if (r == 0 || m.nanos < best.nanos) best = m;
+    }
+    return best;
+}
+
+void eraseBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    const int n = static_cast<int>(opt.size);
+
+    bench::printHeader(cout);
+    for (int percent : {1, 10, 50}) {
+        const int part = n / 100 * percent;
+        const int lo = (n - part) / 2;
+        const string label = to_string(percent) + "% ";
+        if (part == 0) continue;
+
+        auto removeMin = erase(keys, part, opt, [&](Tree& t) {
+            for (int i = 0; i < part; ++i) t.removeMin();
+        });
+        auto before = erase(keys, part, opt, [&](Tree& t) { t.eraseBefore(part); });
+        auto removeMax = erase(keys, part, opt, [&](Tree& t) {
+            for (int i = 0; i < part; ++i) t.removeMax();
+        });
+        auto after = erase(keys, part, opt, [&](Tree& t) { t.eraseAfter(n - 1 - part); });
+        auto remove = erase(keys, part, opt, [&](Tree& t) {
+            for (int k = lo; k < lo + part; ++k) t.remove(k);
+        });
+        auto range = erase(keys, part, opt, [&](Tree& t) { t.eraseRange(lo, lo + part); });
+
+        bench::print(cout, (label + "removeMin loop").c_str(), removeMin);
+        bench::print(cout, (label + "eraseBefore").c_str(), before);
+        bench::print(cout, (label + "removeMax loop").c_str(), removeMax);
+        bench::print(cout, (label + "eraseAfter").c_str(), after);
+        bench::print(cout, (label + "remove loop (middle)").c_str(), remove);
+        bench::print(cout, (label + "eraseRange (middle)").c_str(), range);
+    }
+}
+
+bench::Register reg("erase", "eraseBefore/eraseAfter/eraseRange against removeMin/removeMax/remove loops",
+                    eraseBenchmark);
+
+}  // namespace
@@ -0,0 +1,66 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Trees used as ordered queues: getMin/getMax (cached, O(1)), draining
+ * with removeMin/removeMax, and a steady-state queue where every
+ * insert of a random key is followed by a removeMin (AVLTree only: that
+ * pattern skews a plain BSTree to the right until every operation is O(n)).
+ * */
+
+#include <iostream>
+#include <string>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+template <class Tree>
+void perTree(const string& name, bool queueing, const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    const int n = static_cast<int>(opt.size);
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+
+    auto extremes = bench::measure(opt.repeat, keys.size(), [&] {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            bench::doNotOptimize(tree.getMin());
+            bench::doNotOptimize(tree.getMax());
+        }
+    });
+    bench::Measurement queue;
+    if (queueing) {
+        queue = bench::measure(1, keys.size(), [&] {
+            for (int k : keys) {
+                tree.insert(n + k);  // random keys above the current ones
+                tree.removeMin();
+            }
+        });
+    }
+    auto popMin = bench::measure(1, keys.size(), [&] {
+        while (tree.removeMin()) {}
+    });
+    for (int k : keys) tree.insert(k);
+    auto popMax = bench::measure(1, keys.size(), [&] {
+        while (tree.removeMax()) {}
+    });
+
+    bench::print(cout, (name + " getMin+getMax").c_str(), extremes);
+    if (queueing) bench::print(cout, (name + " insert+removeMin").c_str(), queue);
+    bench::print(cout, (name + " drain removeMin").c_str(), popMin);
+    bench::print(cout, (name + " drain removeMax").c_str(), popMax);
+}
+
+void extremesBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree", false, opt);
+    perTree<trees::AVLTree<int>>("AVLTree", true, opt);
+}
+
+bench::Register reg("extremes", "getMin/getMax, removeMin/removeMax and a min-queue workload",
+                    extremesBenchmark);
+
+}  // namespace
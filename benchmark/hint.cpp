@@ -0,0 +1,68 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Hinted insert and finger search (findFrom) against insert/get from root,
+ * on monotone, nearly-sorted (shuffled within windows of 16) and random keys.
+ * The hint is always the position of the previous key.
+ * */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Tree = trees::AVLTree<int>;
+
+void run(const string& name, const vector<int>& keys, const bench::Options& opt) {
+    Tree tree;
+    auto plain = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (int k : keys) tree.insert(k);
+    });
+    auto hinted = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        Tree::iterator hint = tree.end();
+        for (int k : keys) hint = tree.insert(hint, k).first;
+    });
+    auto get = bench::measure(opt.repeat, keys.size(), [&] {
+        for (int k : keys) bench::doNotOptimize(tree.get(k));
+    });
+    auto finger = bench::measure(opt.repeat, keys.size(), [&] {
+        Tree::iterator from = tree.end();
+        for (int k : keys) {
+            from = tree.findFrom(from, k);
+            bench::doNotOptimize(*from);
+        }
+    });
+    bench::print(cout, (name + " insert").c_str(), plain);
+    bench::print(cout, (name + " insert(hint)").c_str(), hinted);
+    bench::print(cout, (name + " get").c_str(), get);
+    bench::print(cout, (name + " findFrom").c_str(), finger);
+}
+
+void hintBenchmark(const bench::Options& opt) {
+    auto monotone = bench::sequentialKeys(opt.size);
+    auto nearly = monotone;
+    mt19937_64 rng(opt.seed);
+    for (std::size_t i = 0; i < nearly.size(); i += 16)
+        shuffle(nearly.begin() + i, nearly.begin() + min(i + 16, nearly.size()), rng);
+    auto random = bench::shuffledKeys(opt.size, opt.seed);
+
+    bench::printHeader(cout);
+    run("monotone", monotone, opt);
+    run("nearly-sorted", nearly, opt);
+    run("random", random, opt);
+}
+
+bench::Register reg("hint", "AVLTree insert(hint)/findFrom against insert/get from root",
+                    hintBenchmark);
+
+}  // namespace
@@ -0,0 +1,85 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Key storage policies of the nodes (base::storeInline, base::KeyPrefix):
+ * AVLTree of 8-byte keys against 256-byte keys held in the node, held
+ * apart (the default past base::KEY_INLINE_MAX) and held apart with a
+ * cached prefix. Node size, then insert and get (the descent) throughput.
+ * */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+/** Key of Size bytes ordered by its first word, the rest is payload */
+template <std::size_t Size, int Policy>
+struct Key {
+    std::uint64_t id;
+    char payload[Size - sizeof(std::uint64_t)];
+    Key(std::uint64_t id = 0) : id(id) { payload[0] = static_cast<char>(id); }
+    bool operator<(const Key& other) const { return id < other.id; }
+    bool operator>(const Key& other) const { return id > other.id; }
+};
+
+enum { DEFAULT, INLINE, PREFIXED };
+using Key256 = Key<256, DEFAULT>;
+using Key256Inline = Key<256, INLINE>;
+using Key256Prefixed = Key<256, PREFIXED>;
+
+}  // namespace
+
+namespace trees {
+namespace base {
+
+template <> struct storeInline<Key256Inline> : std::true_type {};
+
+template <> struct KeyPrefix<Key256Prefixed> {
+    static constexpr bool enabled = true;
+    static std::uint64_t of(const Key256Prefixed& key) { return key.id; }
+};
+
+}  // namespace base
+}  // namespace trees
+
+namespace {
+
+template <class K>
+void perKey(const string& name, const vector<int>& keys, const bench::Options& opt) {
+    trees::AVLTree<K> tree;
+    cout << name << ": sizeof(key) = " << sizeof(K) << ", sizeof(Node) = "
+         << sizeof(typename trees::AVLTree<K>::Node) << "\n";
+    vector<K> probes(keys.begin(), keys.end());
+
+    auto insert = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (const K& k : probes) tree.insert(k);
+    });
+    auto get = bench::measure(opt.repeat, keys.size(), [&] {
+        for (const K& k : probes) bench::doNotOptimize(tree.get(k));
+    });
+
+    bench::print(cout, (name + " insert").c_str(), insert);
+    bench::print(cout, (name + " get").c_str(), get);
+}
+
+void keystoreBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    bench::printHeader(cout);
+    perKey<std::uint64_t>("8B inline", keys, opt);
+    perKey<Key256Inline>("256B inline", keys, opt);
+    perKey<Key256>("256B apart", keys, opt);
+    perKey<Key256Prefixed>("256B apart+prefix", keys, opt);
+}
+
+bench::Register reg("keystore", "descent with 8 and 256-byte keys, in the node, apart, apart with prefix",
+                    keystoreBenchmark);
+
+}  // namespace
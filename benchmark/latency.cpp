@@ -0,0 +1,73 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Per-operation latency distribution of the tree operations.
+ * Every single call is timed and recorded in a LatencyHistogram, so the
+ * tail (p99, p99.9, max) shows the cost of the rotation cascades in balance()
+ * and of page faults that an average would hide.
+ * */
+
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "LatencyHistogram.hpp"
+
+using namespace std;
+
+namespace {
+
+void header() {
+    cout << left << setw(24) << "operation" << right << setw(10) << "count" << setw(12) << "mean"
+         << setw(9) << "p50" << setw(9) << "p99" << setw(9) << "p99.9" << setw(11) << "max"
+         << "   (ns)\n";
+}
+
+/**
+ * Run every workload against a tree type, printing one row per operation
+ * */
+template <class Tree>
+void latency(const bench::Options& opt) {
+    const auto random = bench::shuffledKeys(opt.size, opt.seed);
+    const auto sorted = bench::sequentialKeys(opt.size);
+    const int n = static_cast<int>(opt.size);
+
+    bench::LatencyHistogram overhead, insertRandom, insertSorted, getHit, getMiss,
+                            removeRandom, removeMin, removeMax, clear;
+
+    for (std::size_t r = 0; r < opt.repeat; ++r) {
+        for (int i = 0; i < 1000; ++i) overhead.time([] {});
+
+        Tree tree;
+        for (int k : sorted) insertSorted.time([&] { tree.insert(k); });
+        clear.time([&] { tree.clear(); });
+
+        for (int k : random) insertRandom.time([&] { tree.insert(k); });
+        for (int k : random) getHit.time([&] { bench::doNotOptimize(tree.get(k)); });
+        for (int k : random) getMiss.time([&] { bench::doNotOptimize(tree.get(k + n)); });
+        for (std::size_t i = 0; i < random.size() / 2; ++i)
+            removeRandom.time([&] { tree.remove(random[i]); });
+        for (std::size_t i = 0; i < random.size() / 8; ++i) {
+            removeMin.time([&] { tree.removeMin(); });
+            removeMax.time([&] { tree.removeMax(); });
+        }
+        clear.time([&] { tree.clear(); });
+    }
+
+    header();
+    overhead.print(cout, "(clock overhead)");
+    insertSorted.print(cout, "insert sequential");
+    insertRandom.print(cout, "insert random");
+    getHit.print(cout, "get hit");
+    getMiss.print(cout, "get miss");
+    removeRandom.print(cout, "remove random");
+    removeMin.print(cout, "removeMin");
+    removeMax.print(cout, "removeMax");
+    clear.print(cout, "clear");
+}
+
+bench::Register avl("latency", "per-operation latency percentiles of AVLTree<int>",
+                    latency<trees::AVLTree<int>>);
+
+}  // namespace
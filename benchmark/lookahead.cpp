@@ -0,0 +1,69 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Full in-order scans with the plain iterator against scanAhead() and its
+ * window sizes, for int keys and for std::string keys (whose characters
+ * live out of the node). GB/s counts the node and string bytes read.
+ * */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+long consume(int key) { return key; }
+long consume(const string& key) { return key[key.size() / 2]; }
+
+std::size_t payload(int) { return 0; }
+std::size_t payload(const string& key) { return key.capacity() + 1; }
+
+template <class K, class Scan>
+void row(const string& label, const trees::AVLTree<K>& tree, double bytes, Scan&& scan,
+         std::size_t n, const bench::Options& opt) {
+    auto m = bench::measure(opt.repeat, n, [&] {
+        long sum = 0;
+        for (const K& key : scan(tree)) sum += consume(key);
+        bench::doNotOptimize(sum);
+    });
+    cout << left << setw(28) << label << right << fixed << setprecision(1)
+         << setw(10) << m.nanos << setprecision(2) << setw(10) << bytes / n / m.nanos << '\n';
+}
+
+template <class K>
+void perKey(const string& type, const vector<K>& keys, const bench::Options& opt) {
+    trees::AVLTree<K> tree;
+    double bytes = 0;
+    for (const K& k : keys) tree.insert(k);
+    for (const K& k : tree) bytes += sizeof(typename trees::AVLTree<K>::Node) + payload(k);
+
+    using Tree = trees::AVLTree<K>;
+    row(type + " iterator", tree, bytes, [](const Tree& t) -> const Tree& { return t; },
+        keys.size(), opt);
+    for (std::size_t window : {1, 2, 4, 8, 16}) {
+        row(type + " scanAhead(" + to_string(window) + ")", tree, bytes,
+            [window](const Tree& t) { return t.scanAhead(window); }, keys.size(), opt);
+    }
+}
+
+void lookaheadBenchmark(const bench::Options& opt) {
+    const auto random = bench::shuffledKeys(opt.size, opt.seed);
+    vector<string> strings;
+    for (int k : random) strings.push_back("a somewhat long key, out of SSO " + to_string(k));
+
+    cout << left << setw(28) << "per element" << right << setw(10) << "ns" << setw(10) << "GB/s"
+         << '\n';
+    perKey<int>("int", random, opt);
+    perKey<string>("string", strings, opt);
+}
+
+bench::Register reg("lookahead", "full scans with the plain iterator against scanAhead(window)",
+                    lookaheadBenchmark);
+
+}  // namespace
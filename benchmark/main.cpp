@@ -0,0 +1,71 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Benchmark.hpp"
+
+using namespace std;
+
+namespace bench {
+
+vector<Benchmark>& registry() {
+    static vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool& failed() {
+    static bool any = false;
+    return any;
+}
+
+}  // namespace bench
+
+static void usage(const char *program) {
+    cout << "Usage: " << program << " [-n size] [-r repeat] [-s seed] [workload...]\n"
+         << "Runs the given workloads, or all of them when none is given.\n\n"
+         << "Workloads:\n";
+    for (const auto& b : bench::registry())
+        cout << "  " << left << setw(22) << b.name << b.description << '\n';
+}
+
+int main(int argc, char *argv[]) {
+    bench::Options opt;
+    vector<string> selected;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if ((arg == "-n" || arg == "-r" || arg == "-s") && i + 1 < argc) {
+            auto value = strtoull(argv[++i], nullptr, 10);
+            if (arg == "-n") opt.size = value;
+            if (arg == "-r") opt.repeat = value ? value : 1;
+            if (arg == "-s") opt.seed = value;
+        } else if (arg == "-h" || arg == "--help") {
+            usage(argv[0]);
+            return 0;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            selected.push_back(arg);
+        }
+    }
+
+    bool ran = false;
+    for (const auto& b : bench::registry()) {
+        bool wanted = selected.empty();
+        for (const auto& name : selected) wanted |= (name == b.name);
+        if (!wanted) continue;
+        cout << "==== " << b.name << " (n = " << opt.size << ") ====\n";
+        b.run(opt);
+        cout << endl;
+        ran = true;
+    }
+    if (!ran) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return bench::failed() ? 1 : 0;
+}
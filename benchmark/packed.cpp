@@ -0,0 +1,91 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * AVLTree (int height in the node) against PackedAVLTree (balance factor
+ * in the child pointers' low bits): node size, heap bytes per element
+ * as seen by malloc (glibc only), and insert/get/remove throughput
+ * with int and std::string keys.
+ * */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "PackedAVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/** Bytes currently allocated by malloc, 0 where unknown */
+std::size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+template <class K> K makeKey(int k);
+template <> int makeKey<int>(int k) { return k; }
+template <> string makeKey<string>(int k) { return "key:" + to_string(k); }
+
+template <class Tree, class K>
+void perTree(const string& name, const vector<K>& keys, const vector<K>& sorted,
+             const bench::Options& opt) {
+    Tree tree;
+    std::size_t heap = heapInUse();
+    for (const K& k : keys) tree.insert(k);
+    heap = heapInUse() - heap;
+    cout << name << ": sizeof(Node) = " << sizeof(typename Tree::Node)
+         << ", heap per element = " << (heap ? to_string(heap / keys.size()) : string("n/a"))
+         << " bytes\n";
+
+    auto insertRandom = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (const K& k : keys) tree.insert(k);
+    });
+    auto get = bench::measure(opt.repeat, keys.size(), [&] {
+        for (const K& k : keys) bench::doNotOptimize(tree.get(k));
+    });
+    auto remove = bench::measure(1, keys.size(), [&] {
+        for (const K& k : keys) tree.remove(k);
+    });
+    auto insertSorted = bench::measure(opt.repeat, sorted.size(), [&] {
+        tree.clear();
+        for (const K& k : sorted) tree.insert(k);
+    });
+
+    bench::print(cout, (name + " insert random").c_str(), insertRandom);
+    bench::print(cout, (name + " insert sequential").c_str(), insertSorted);
+    bench::print(cout, (name + " get").c_str(), get);
+    bench::print(cout, (name + " remove random").c_str(), remove);
+}
+
+template <class K>
+void perKey(const string& type, const bench::Options& opt) {
+    vector<K> keys, sorted;
+    for (int k : bench::shuffledKeys(opt.size, opt.seed)) keys.push_back(makeKey<K>(k));
+    sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    perTree<trees::AVLTree<K>>("AVL<" + type + ">", keys, sorted, opt);
+    perTree<trees::PackedAVLTree<K>>("Packed<" + type + ">", keys, sorted, opt);
+}
+
+void packedBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perKey<int>("int", opt);
+    perKey<string>("string", opt);
+}
+
+bench::Register reg("packed", "node size, heap and throughput of AVLTree against PackedAVLTree",
+                    packedBenchmark);
+
+}  // namespace
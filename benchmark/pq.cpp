@@ -0,0 +1,134 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * TreePriorityQueue against std::priority_queue and std::multiset:
+ * push then drain, the "hold" model of schedulers (pop the minimum,
+ * push it back later in time), decrease-key through handles
+ * (multiset: erase by iterator + insert) and draining in batches with popK.
+ * Checks the order of equal priorities, updated or not, first.
+ * */
+
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "TreePriorityQueue.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Queue = trees::TreePriorityQueue<int>;
+using Heap = priority_queue<int, vector<int>, greater<int>>;
+
+/** Element ordered by priority alone, the name tells equals apart */
+struct Job {
+    int priority;
+    char name;
+    bool operator<(const Job& other) const { return priority < other.priority; }
+};
+
+/**
+ * Ties are served in push order, an updated element counting as pushed again
+ * */
+void checkTies() {
+    trees::TreePriorityQueue<Job> jobs;
+    auto a = jobs.push({5, 'a'});
+    jobs.push({5, 'b'});
+    auto c = jobs.push({7, 'c'});
+    jobs.push({5, 'd'});
+    jobs.updatePriority(c, {5, 'c'});
+    jobs.updatePriority(a, {5, 'a'});
+    string served;
+    while (auto job = jobs.popMin()) served += job->name;
+    bench::check(served == "bdca", "TreePriorityQueue ties after updatePriority");
+}
+
+void pqBenchmark(const bench::Options& opt) {
+    checkTies();
+    const std::size_t n = opt.size;
+    mt19937_64 rng(opt.seed);
+    vector<int> priorities(n), delays(n), changes(n);
+    for (int& p : priorities) p = static_cast<int>(rng() % (4 * n));
+    for (int& d : delays) d = static_cast<int>(rng() % 1000);
+    for (int& c : changes) c = static_cast<int>(rng() % n);
+
+    bench::printHeader(cout);
+
+    // push everything, then drain by the minimum
+    Queue queue;
+    bench::print(cout, "TreePriorityQueue push+pop", bench::measure(opt.repeat, n, [&] {
+        for (int p : priorities) queue.push(p);
+        while (queue.popMin()) {}
+    }));
+    Heap heap;
+    bench::print(cout, "priority_queue push+pop", bench::measure(opt.repeat, n, [&] {
+        for (int p : priorities) heap.push(p);
+        while (!heap.empty()) heap.pop();
+    }));
+    multiset<int> set;
+    bench::print(cout, "multiset push+pop", bench::measure(opt.repeat, n, [&] {
+        for (int p : priorities) set.insert(p);
+        while (!set.empty()) set.erase(set.begin());
+    }));
+
+    // hold model: the minimum is rescheduled a bit later
+    for (int p : priorities) {
+        queue.push(p);
+        heap.push(p);
+        set.insert(p);
+    }
+    bench::print(cout, "TreePriorityQueue hold", bench::measure(1, n, [&] {
+        for (int d : delays) queue.push(*queue.popMin() + d);
+    }));
+    bench::print(cout, "priority_queue hold", bench::measure(1, n, [&] {
+        for (int d : delays) {
+            int p = heap.top();
+            heap.pop();
+            heap.push(p + d);
+        }
+    }));
+    bench::print(cout, "multiset hold", bench::measure(1, n, [&] {
+        for (int d : delays) {
+            int p = *set.begin();
+            set.erase(set.begin());
+            set.insert(p + d);
+        }
+    }));
+
+    // decrease-key of random elements
+    queue.clear();
+    set.clear();
+    vector<Queue::Handle> handles;
+    vector<multiset<int>::iterator> positions;
+    for (int p : priorities) {
+        handles.push_back(queue.push(p));
+        positions.push_back(set.insert(p));
+    }
+    bench::print(cout, "TreePriorityQueue decrease", bench::measure(1, n, [&] {
+        for (int c : changes) queue.updatePriority(handles[c], handles[c].priority() - 1);
+    }));
+    bench::print(cout, "multiset decrease", bench::measure(1, n, [&] {
+        for (int c : changes) {
+            int p = *positions[c];
+            set.erase(positions[c]);
+            positions[c] = set.insert(p - 1);
+        }
+    }));
+
+    // batched drain
+    vector<int> out(64);
+    bench::print(cout, "TreePriorityQueue popK(64)", bench::measure(1, n, [&] {
+        while (queue.popK(out.size(), out.data()) > 0) {}
+    }));
+}
+
+bench::Register reg("pq", "TreePriorityQueue against std::priority_queue and std::multiset",
+                    pqBenchmark);
+
+}  // namespace
@@ -0,0 +1,58 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Lookup and insert throughput with each prefetching mode (ePrefetch).
+ * Prefetching only pays off when the nodes do not fit in the cache,
+ * so run it with a -n big enough for the tree to exceed the LLC
+ * (around 40 bytes per AVLTree<int> node).
+ * */
+
+#include <iostream>
+#include <string>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+const trees::ePrefetch modes[] = {
+    trees::NO_PREFETCH, trees::PREFETCH_CHILDREN, trees::PREFETCH_GRANDCHILDREN
+};
+const char *modeNames[] = {"none", "children", "grandchildren"};
+
+template <class Tree>
+void perTree(const char *name, const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    const auto probes = bench::shuffledKeys(opt.size, opt.seed + 1);
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+
+    for (int m = 0; m < 3; ++m) {
+        tree.setPrefetch(modes[m]);
+        auto get = bench::measure(opt.repeat, probes.size(), [&] {
+            for (int k : probes) bench::doNotOptimize(tree.get(k));
+        });
+        Tree fresh;
+        fresh.setPrefetch(modes[m]);
+        auto insert = bench::measure(1, keys.size(), [&] {
+            for (int k : keys) fresh.insert(k);
+        });
+        string label = string(name) + " " + modeNames[m];
+        bench::print(cout, (label + " get").c_str(), get);
+        bench::print(cout, (label + " insert").c_str(), insert);
+    }
+}
+
+void prefetchBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree", opt);
+    perTree<trees::AVLTree<int>>("AVLTree", opt);
+}
+
+bench::Register reg("prefetch", "get/insert with each ePrefetch mode (use a -n beyond the LLC)",
+                    prefetchBenchmark);
+
+}  // namespace
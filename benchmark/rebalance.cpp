@@ -0,0 +1,89 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * BSTree fed sorted keys: the degenerate tree (capped at 20000 keys, every
+ * operation is O(n)), one rebalance() after the load, and the automatic
+ * rebuild of setAutoRebalance(c), from root and through insert(hint),
+ * against AVLTree. Per key inserted or got.
+ * */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+/** BSTree<int> telling its depth, to check the automatic rebuild */
+struct LeveledTree : trees::BSTree<int> {
+    std::size_t depth() const {  // level by level, the tree may be a long chain
+        std::size_t levels = 0;
+        vector<const Node*> level, next;
+        if (root != nullptr) level.push_back(root);
+        for (; !level.empty(); ++levels, level.swap(next)) {
+            next.clear();
+            for (const Node *node : level) {
+                if (node->left != nullptr) next.push_back(node->left);
+                if (node->right != nullptr) next.push_back(node->right);
+            }
+        }
+        return levels;
+    }
+};
+
+template <class Tree>
+void perTree(const string& name, std::size_t n, double factor, bool rebalance,
+             const bench::Options& opt, bool hinted = false) {
+    const auto sorted = bench::sequentialKeys(n);
+    const auto probes = bench::shuffledKeys(n, opt.seed);
+    Tree tree;
+    tree.setAutoRebalance(factor);
+
+    auto insert = bench::measure(1, n, [&] {
+        typename Tree::iterator hint = tree.end();
+        for (int k : sorted) {
+            if (hinted) hint = tree.insert(hint, k).first;
+            else tree.insert(k);
+        }
+    });
+    bench::print(cout, (name + " insert").c_str(), insert);
+    if constexpr (std::is_same<Tree, LeveledTree>::value) {
+        if (factor > 0) {
+            bench::check(tree.depth() <= factor * std::log2(n) + 2,
+                         "setAutoRebalance() bounds the depth of sorted loads");
+        }
+    }
+    if (rebalance) {
+        auto reshape = bench::measure(1, n, [&] { tree.rebalance(); });
+        bench::print(cout, (name + " rebalance()").c_str(), reshape);
+    }
+    auto get = bench::measure(opt.repeat, n, [&] {
+        for (int k : probes) bench::doNotOptimize(tree.get(k));
+    });
+    bench::print(cout, (name + " get").c_str(), get);
+}
+
+void rebalanceBenchmark(const bench::Options& opt) {
+    const std::size_t degenerate = std::min<std::size_t>(opt.size, 20000);
+    const string small = " n=" + to_string(degenerate);
+
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree" + small, degenerate, 0, false, opt);
+    perTree<trees::BSTree<int>>("BSTree+rebalance" + small, degenerate, 0, true, opt);
+    perTree<LeveledTree>("BSTree auto c=2", opt.size, 2, false, opt);
+    perTree<LeveledTree>("BSTree auto c=4", opt.size, 4, false, opt);
+    perTree<LeveledTree>("BSTree auto c=2 hint", opt.size, 2, false, opt, true);
+    perTree<trees::AVLTree<int>>("AVLTree", opt.size, 0, false, opt);
+}
+
+bench::Register reg("rebalance", "sorted loads into BSTree: degenerate, rebalance(), auto rebuild, AVL",
+                    rebalanceBenchmark);
+
+}  // namespace
@@ -0,0 +1,101 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * AVL retracing after insert and remove: time per operation and, in a
+ * build with the trees' counters (make STATS=1), the average number of
+ * nodes retraced against the path length, which is what retracing up to
+ * root (before the early stop on unchanged heights) visited.
+ * */
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Tree = trees::AVLTree<int>;
+
+struct Row {
+    string label;
+    bench::Measurement m;
+    double pathNodes = 0;  // per operation
+    double retraced = 0;
+};
+
+/**
+ * Time one pass of an operation over the keys, counting its retracing work
+ * */
+template <class F>
+Row run(const string& label, Tree& tree, std::size_t ops, F&& workload) {
+    Row row;
+    row.label = label;
+#ifdef TREES_STATS
+    auto before = tree.stats;
+#endif
+    row.m = bench::measure(1, ops, workload);
+#ifdef TREES_STATS
+    row.pathNodes = static_cast<double>(tree.stats.pathNodes - before.pathNodes) / ops;
+    row.retraced = static_cast<double>(tree.stats.retraced - before.retraced) / ops;
+#endif
+    return row;
+}
+
+void retraceBenchmark(const bench::Options& opt) {
+    const auto random = bench::shuffledKeys(opt.size, opt.seed);
+    const auto sorted = bench::sequentialKeys(opt.size);
+    const int n = static_cast<int>(opt.size);
+    vector<Row> rows;
+
+    for (std::size_t r = 0; r < opt.repeat; ++r) {
+        Tree tree;
+        rows.push_back(run("insert sequential", tree, sorted.size(), [&] {
+            for (int k : sorted) tree.insert(k);
+        }));
+        rows.push_back(run("remove sequential", tree, sorted.size(), [&] {
+            for (int k : sorted) tree.remove(k);
+        }));
+        rows.push_back(run("insert random", tree, random.size(), [&] {
+            for (int k : random) tree.insert(k);
+        }));
+        rows.push_back(run("insert+removeMin", tree, random.size(), [&] {
+            for (int k : random) {
+                tree.insert(n + k);
+                tree.removeMin();
+            }
+        }));
+        rows.push_back(run("remove random", tree, random.size(), [&] {
+            for (int k : random) tree.remove(n + k);
+        }));
+    }
+
+    // keep the fastest repetition of each operation
+    const std::size_t kinds = rows.size() / opt.repeat;
+    for (std::size_t i = kinds; i < rows.size(); ++i)
+        if (rows[i].m.nanos < rows[i % kinds].m.nanos) rows[i % kinds] = rows[i];
+    rows.resize(kinds);
+
+#ifdef TREES_STATS
+    cout << left << setw(24) << "per operation" << right << setw(10) << "ns"
+         << setw(12) << "path" << setw(12) << "retraced" << '\n';
+    for (const Row& row : rows) {
+        cout << left << setw(24) << row.label << right << fixed << setprecision(1)
+             << setw(10) << row.m.nanos << setprecision(2)
+             << setw(12) << row.pathNodes << setw(12) << row.retraced << '\n';
+    }
+#else
+    cout << "(build with make STATS=1 to count the nodes retraced)\n";
+    bench::printHeader(cout);
+    for (const Row& row : rows) bench::print(cout, row.label.c_str(), row.m);
+#endif
+}
+
+bench::Register reg("retrace", "AVL nodes retraced per insert/remove against the path length",
+                    retraceBenchmark);
+
+}  // namespace
@@ -0,0 +1,60 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * In-order scans: the path-keeping iterator of AVLTree against the
+ * stackless scan() of AVLTree<T, ParentAVLNode>, with the node size and
+ * iterator size of each layout and what keeping the parent links costs
+ * to insert and remove.
+ * */
+
+#include <iostream>
+#include <string>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using StackTree = trees::AVLTree<int>;
+using ParentTree = trees::AVLTree<int, trees::ParentAVLNode>;
+
+template <class Tree, class Scan>
+void perTree(const string& name, std::size_t iteratorSize, Scan&& scan,
+             const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    Tree tree;
+    cout << name << ": sizeof(Node) = " << sizeof(typename Tree::Node)
+         << ", sizeof(iterator) = " << iteratorSize << " bytes\n";
+
+    auto insert = bench::measure(opt.repeat, keys.size(), [&] {
+        tree.clear();
+        for (int k : keys) tree.insert(k);
+    });
+    auto full = bench::measure(opt.repeat, keys.size(), [&] {
+        long sum = 0;
+        for (int k : scan(tree)) sum += k;
+        bench::doNotOptimize(sum);
+    });
+    auto remove = bench::measure(1, keys.size(), [&] {
+        for (int k : keys) tree.remove(k);
+    });
+
+    bench::print(cout, (name + " insert").c_str(), insert);
+    bench::print(cout, (name + " scan").c_str(), full);
+    bench::print(cout, (name + " remove").c_str(), remove);
+}
+
+void scanBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perTree<StackTree>("path iterator", sizeof(StackTree::iterator),
+                       [](StackTree& t) -> StackTree& { return t; }, opt);
+    perTree<ParentTree>("parent scan()", sizeof(ParentTree::scan_iterator),
+                        [](ParentTree& t) { return t.scan(); }, opt);
+}
+
+bench::Register reg("scan", "in-order scan with the path iterator against parent links (scan())",
+                    scanBenchmark);
+
+}  // namespace
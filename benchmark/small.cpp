@@ -0,0 +1,67 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * SmallAVLTree<int> (up to 16 elements in an array, then an AVLTree)
+ * against AVLTree<int> by element count, 0 to 1000: filling a fresh tree,
+ * get of every key (a miss for the empty tree) and removing then inserting
+ * every key, repeated over about -n operations per count.
+ * */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "SmallAVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+template <class Tree>
+void perTree(const string& name, const vector<int>& keys, const bench::Options& opt) {
+    const std::size_t per = keys.size() ? keys.size() : 1;  // operations per round
+    const std::size_t rounds = opt.size / per ? opt.size / per : 1;
+    const vector<int> probes = keys.empty() ? vector<int>{0} : keys;
+
+    auto fill = bench::measure(opt.repeat, rounds * per, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            Tree tree;
+            for (int k : keys) tree.insert(k);
+            bench::doNotOptimize(tree.getMin());
+        }
+    });
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+    auto get = bench::measure(opt.repeat, rounds * per, [&] {
+        for (std::size_t r = 0; r < rounds; ++r)
+            for (int k : probes) bench::doNotOptimize(tree.get(k));
+    });
+    auto churn = bench::measure(opt.repeat, rounds * per, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (int k : keys) tree.remove(k);
+            for (int k : keys) tree.insert(k);
+        }
+    });
+
+    bench::print(cout, (name + " fill new").c_str(), fill);
+    bench::print(cout, (name + " get").c_str(), get);
+    bench::print(cout, (name + " remove+insert").c_str(), churn);
+}
+
+void smallBenchmark(const bench::Options& opt) {
+    cout << "sizeof(AVLTree<int>) = " << sizeof(trees::AVLTree<int>)
+         << ", sizeof(SmallAVLTree<int>) = " << sizeof(trees::SmallAVLTree<int>) << "\n";
+    bench::printHeader(cout);
+    for (std::size_t n : {0, 1, 2, 4, 8, 12, 16, 17, 32, 64, 128, 256, 1000}) {
+        const auto keys = bench::shuffledKeys(n, opt.seed);
+        perTree<trees::AVLTree<int>>("AVL n=" + to_string(n), keys, opt);
+        perTree<trees::SmallAVLTree<int>>("Small n=" + to_string(n), keys, opt);
+    }
+}
+
+bench::Register reg("small", "SmallAVLTree (inline array up to 16) against AVLTree, 0 to 1000 keys",
+                    smallBenchmark);
+
+}  // namespace
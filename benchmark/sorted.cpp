@@ -0,0 +1,65 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Sorted batched lookups (getSortedBatch, containsSorted) against
+ * per-key get() and getBatch(), for sorted batches of 1K up to 1M keys
+ * (bounded by -n) probing a tree of -n keys, half of them missing.
+ * */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "BSTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+template <class Tree>
+void perTree(const char *name, const bench::Options& opt) {
+    // even keys in the tree, probes over the whole range: half hit, half miss
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    Tree tree;
+    for (int k : keys) tree.insert(2 * k);
+
+    mt19937_64 rng(opt.seed + 1);
+    uniform_int_distribution<int> any(0, 2 * static_cast<int>(opt.size) - 1);
+    for (std::size_t m = 1000; m <= 1000000 && m <= opt.size; m *= 10) {
+        vector<int> probes(m);
+        for (int& p : probes) p = any(rng);
+        sort(probes.begin(), probes.end());
+        vector<int*> out(m);
+        string label = string(name) + " m=" + to_string(m);
+
+        auto loop = bench::measure(opt.repeat, m, [&] {
+            for (std::size_t i = 0; i < m; ++i) out[i] = tree.get(probes[i]);
+            bench::doNotOptimize(out.data());
+        });
+        auto batch = bench::measure(opt.repeat, m, [&] {
+            tree.getBatch(probes.data(), m, out.data());
+            bench::doNotOptimize(out.data());
+        });
+        auto sorted = bench::measure(opt.repeat, m, [&] {
+            bench::doNotOptimize(tree.getSortedBatch(probes.data(), m, out.data()));
+        });
+        bench::print(cout, (label + " get loop").c_str(), loop);
+        bench::print(cout, (label + " getBatch").c_str(), batch);
+        bench::print(cout, (label + " getSortedBatch").c_str(), sorted);
+    }
+}
+
+void sortedBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perTree<trees::BSTree<int>>("BSTree", opt);
+    perTree<trees::AVLTree<int>>("AVLTree", opt);
+}
+
+bench::Register reg("sorted", "getSortedBatch on sorted batches of 1K-1M keys against get()",
+                    sortedBenchmark);
+
+}  // namespace
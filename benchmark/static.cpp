@@ -0,0 +1,75 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * StaticAVLTree<int, N> (nodes in an array in the tree, no heap) against
+ * AVLTree<int> (one heap node per element) at small sizes: filling a
+ * fresh tree, get of every key and removing them all, repeated over
+ * about -n operations per size, plus the footprint of each tree.
+ * */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "StaticAVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+template <class Tree>
+void perTree(const string& name, const vector<int>& keys, const bench::Options& opt) {
+    const std::size_t rounds = opt.size / keys.size() ? opt.size / keys.size() : 1;
+    const std::size_t ops = rounds * keys.size();
+
+    auto fill = bench::measure(opt.repeat, ops, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            Tree tree;
+            for (int k : keys) tree.insert(k);
+            bench::doNotOptimize(tree.getMin());
+        }
+    });
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+    auto get = bench::measure(opt.repeat, ops, [&] {
+        for (std::size_t r = 0; r < rounds; ++r)
+            for (int k : keys) bench::doNotOptimize(tree.get(k));
+    });
+    auto churn = bench::measure(opt.repeat, ops, [&] {
+        for (std::size_t r = 0; r < rounds; ++r) {
+            for (int k : keys) tree.remove(k);
+            for (int k : keys) tree.insert(k);
+        }
+    });
+
+    bench::print(cout, (name + " fill new").c_str(), fill);
+    bench::print(cout, (name + " get").c_str(), get);
+    bench::print(cout, (name + " remove+insert").c_str(), churn);
+}
+
+template <std::size_t N>
+void perSize(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(N, opt.seed);
+    using Static = trees::StaticAVLTree<int, N>;
+    cout << "N = " << N << ": sizeof(StaticAVLTree) = " << sizeof(Static)
+         << ", sizeof(AVLTree) = " << sizeof(trees::AVLTree<int>)
+         << " + " << sizeof(trees::AVLNode<int>) << " heap bytes per element\n";
+    perTree<trees::AVLTree<int>>("AVL<" + to_string(N) + ">", keys, opt);
+    perTree<Static>("Static<" + to_string(N) + ">", keys, opt);
+}
+
+void staticBenchmark(const bench::Options& opt) {
+    bench::printHeader(cout);
+    perSize<8>(opt);
+    perSize<16>(opt);
+    perSize<64>(opt);
+    perSize<256>(opt);
+    perSize<1024>(opt);
+}
+
+bench::Register reg("static", "StaticAVLTree against heap-backed AVLTree at 8 to 1024 elements",
+                    staticBenchmark);
+
+}  // namespace
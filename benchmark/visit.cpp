@@ -0,0 +1,104 @@
+/* Copyright 2017 Natanael Josue Rabello */
+
+/**
+ * Early-exit queries: the first key of a range matching a predicate, by
+ * printing the whole tree (the only traversal before visit()), by a full
+ * traverse(), by a traverse() loop that breaks and by visit() with STOP;
+ * and the splitters of the top tree levels, by filtering every node
+ * against a visit() that SKIPs the sub-trees below them (AVL heights).
+ * */
+
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "AVLTree.hpp"
+#include "Benchmark.hpp"
+#include "PerfCounters.hpp"
+
+using namespace std;
+
+namespace {
+
+using Tree = trees::AVLTree<int>;
+
+/** Output stream that discards everything, for print() */
+struct NullBuffer : streambuf {
+    int overflow(int c) override { return c; }
+};
+
+void visitBenchmark(const bench::Options& opt) {
+    const auto keys = bench::shuffledKeys(opt.size, opt.seed);
+    const int n = static_cast<int>(opt.size);
+    Tree tree;
+    for (int k : keys) tree.insert(k);
+
+    NullBuffer buffer;
+    ostream null(&buffer);
+    const int lo = n / 100;  // first key >= lo that is a multiple of 7
+    auto matches = [lo](int k) { return k >= lo && k % 7 == 0; };
+
+    bench::printHeader(cout);
+    auto print = bench::measure(opt.repeat, 1, [&] { tree.print(null, trees::INORDER); });
+    auto full = bench::measure(opt.repeat, 1, [&] {
+        int found = -1;
+        for (int k : tree.traverse(trees::INORDER))
+            if (found < 0 && matches(k)) found = k;
+        bench::doNotOptimize(found);
+    });
+    auto loop = bench::measure(opt.repeat, 1, [&] {
+        int found = -1;
+        for (int k : tree.traverse(trees::INORDER)) {
+            if (matches(k)) {
+                found = k;
+                break;
+            }
+        }
+        bench::doNotOptimize(found);
+    });
+    auto visit = bench::measure(opt.repeat, 1, [&] {
+        int found = -1;
+        tree.visit(trees::INORDER, [&](const int& k) {
+            if (!matches(k)) return trees::CONTINUE;
+            found = k;
+            return trees::STOP;
+        });
+        bench::doNotOptimize(found);
+    });
+    bench::print(cout, "first match: print all", print);
+    bench::print(cout, "first match: traverse all", full);
+    bench::print(cout, "first match: traverse+break", loop);
+    bench::print(cout, "first match: visit STOP", visit);
+
+    // splitters: the nodes of the top levels, where height > root height - levels
+    const int levels = 10;
+    vector<int> splitters;
+    auto filter = bench::measure(opt.repeat, 1, [&] {
+        splitters.clear();
+        int root = 0;
+        tree.visit(trees::PREORDER, [&](const Tree::Node& node) {
+            if (root == 0) root = node.height;
+            if (node.height > root - levels) splitters.push_back(node.key);
+            return trees::CONTINUE;
+        });
+    });
+    auto prune = bench::measure(opt.repeat, 1, [&] {
+        splitters.clear();
+        int root = 0;
+        tree.visit(trees::PREORDER, [&](const Tree::Node& node) {
+            if (root == 0) root = node.height;
+            if (node.height <= root - levels) return trees::SKIP;
+            splitters.push_back(node.key);
+            return trees::CONTINUE;
+        });
+    });
+    bench::print(cout, "splitters: visit all", filter);
+    bench::print(cout, ("splitters: visit SKIP (" + to_string(splitters.size()) + ")").c_str(),
+                 prune);
+}
+
+bench::Register reg("visit", "early-exit (STOP) and pruned (SKIP) visit() queries per query",
+                    visitBenchmark);
+
+}  // namespace
@@ -36,6 +36,14 @@ IN THE SOFTWARE.
  * avl.remove(t1)
  * T *t = avl.get(t2);
  * avl.print(cout, INORDER);  // ou cout << avl;
+ *
+ * AVLTree<T, ParentAVLNode> linked;  // nodes also linked to their parent
+ * for (const T& t : linked.scan()) ...  // stackless in-order traversal
+ *
+ * BSTree<T, AVLNode> load;  // no balancing cost while loading
+ * AVLTree<T> serve(std::move(load));  // same nodes, relinked balanced in O(n)
+ * BSTree<T, AVLNode> back(std::move(serve));  // and back, as they are
+ * AVLTree<T> copy = avl.clone();  // deep copy, heights included
  * 
  * */
 
@@ -45,6 +53,7 @@ IN THE SOFTWARE.
 #include <memory>
 #include <utility>
 #include <ostream>
+#include <type_traits>
 #include "BSTree.hpp"
 
 
@@ -79,47 +88,85 @@ struct AVLNode : public base::AVLNode<T, AVLNode> {
     ~AVLNode() {}
 };
 
+/** AVLNode linked to its parent too, for stackless iteration (BSTree::scan()) */
+template <class T>
+struct ParentAVLNode : public base::AVLNode<T, ParentAVLNode> {
+    ParentAVLNode *parent = nullptr;
+    using base::AVLNode<T, ParentAVLNode>::AVLNode;
+    ~ParentAVLNode() {}
+};
+
 
 
 /* ^^^^^^^^^
  * AVL Tree
  * ^^^^^^^^^ */
-template <class T>
-class AVLTree : public BSTree<T, AVLNode> {
-    using Base = BSTree<T, AVLNode>;
+template <class T, template<typename ...> class N = AVLNode>
+class AVLTree : public BSTree<T, N> {
+    using Base = BSTree<T, N>;
 
  public:
-    using Node = AVLNode<T>;  // aliases for the node type
+    using Node = N<T>;  // aliases for the node type
+    using typename Base::iterator;
 
     AVLTree() : Base() {}
+    AVLTree(const AVLTree &other) = default;
+    AVLTree(AVLTree &&other) noexcept = default;
+    template <template<typename ...> class M> explicit AVLTree(BSTree<T, M> &&other);
     ~AVLTree() {}
+    AVLTree& operator=(const AVLTree &other) = default;
+    AVLTree& operator=(AVLTree &&other) noexcept = default;
 
     /* Metodos externos */
     // bool Tree::isEmpty() const;
     // void BSTree::clear();
+    AVLTree clone(unsigned threads = 1) const;
     // T* BSTree::get(T key) const;
-    // T* BSTree::getMax() const;
-    // T* BSTree::getMin() const;
-    using Base::insert;  // use of the same insert(T key) from base which calls protected insert
+    // T* BSTree::getMax() const;  O(1)
+    // T* BSTree::getMin() const;  O(1)
+    // void BSTree::getBatch(const T *keys, std::size_t count, T **out) const;
+    // std::size_t BSTree::getSortedBatch(const T *keys, std::size_t count, T **out) const;
+    // bool BSTree::containsSorted(const T *keys, std::size_t count) const;
+    // bool BSTree::insert(T key);  (balanced by retrace())
+    // std::pair<iterator, bool> BSTree::insert(iterator hint, T key);  (balanced by retrace())
+    // iterator BSTree::begin() const;
+    // iterator BSTree::end() const;
+    // iterator BSTree::find(T key) const;
+    // iterator BSTree::findFrom(iterator from, T key) const;
+    // Range<scan_iterator> BSTree::scan() const;  (N = ParentAVLNode only)
+    // scan_iterator BSTree::scanFind(T key) const;  (N = ParentAVLNode only)
+    // Range<lookahead_iterator> BSTree::scanAhead(std::size_t window = 8) const;
+    // Range<order_iterator> BSTree::traverse(eOrder order = INORDER) const;
+    // bool BSTree::visit(eOrder order, Visitor&& visitor) const;
     std::unique_ptr<T> remove(T key) override;
-    std::unique_ptr<T> removeMax() override;
-    std::unique_ptr<T> removeMin() override;
+    // std::unique_ptr<T> BSTree::removeMax();  (balanced by retrace())
+    // std::unique_ptr<T> BSTree::removeMin();  (balanced by retrace())
+    std::size_t eraseRange(const T &lo, const T &hi);
+    std::size_t eraseBefore(const T &key);
+    std::size_t eraseAfter(const T &key);
     // std::ostream& BSTree::print(std::ostream& os, eOrder order = INORDER) const;
+    // void BSTree::setPrefetch(ePrefetch mode);
+    // std::size_t BSTree::size() const;
+    // void BSTree::rebalance();  (heights recomputed)
 
     template <class _T> friend AVLTree<_T>& operator<<(AVLTree<_T>& avl, _T key);
     template <class _T> friend std::ostream& operator<<(std::ostream& os, const AVLTree<_T>& avl);
 
  protected:
     using Base::root;
+    using typename Base::Path;
 
     /* Metodos internos */
-    bool insert(Node *&node, T &key) override;
-    std::unique_ptr<T> remove(Node *&node, T &key);
-    Node* pullMax(Node *&node);
     void balance(Node *&node);
     int  bFactor(Node *node);
     void rotateLeft(Node *&node);
     void rotateRight(Node *&node);
+    std::size_t retrace(Path &path, std::size_t dirty) override;
+    static int height(const Node *node) { return node ? node->height : 0; }
+    Node* join(Node *left, Node *mid, Node *right);
+    Node* join(Node *left, Node *right);
+    Node* takeMin(Node *&node);
+    void split(Node *node, const T &key, bool equalLeft, Node *&left, Node *&right);
 };
 
 
@@ -141,109 +188,214 @@ int base::AVLNode<T, N>::updateHeight() {
 }
 
 /**
- * Insert a element in the tree
- * @return true if element was inserted succefully, or false if it already exists
- * @see BSTree::insert(T key)
+ * Take the elements of a BSTree (e.g. filled without balancing cost) as a
+ * balanced AVLTree, leaving it empty. With the same node layout (BSTree<T, N>)
+ * its nodes are relinked perfectly balanced, heights set, in one in-order pass:
+ * O(n) time, no allocation. @see BSTree(BSTree<T, M>&&), BSTree::relink()
  * */
-template <class T>
-bool AVLTree<T>::insert(Node *&node, T &key) {
-    if (node == nullptr) {
-        node = new Node(key);
-        return true;
-    }
-    if (key == node->key) return false;
-    if (key < node->key) {
-        if (!insert(node->left, key)) return false;
-    } else {
-        if (!insert(node->right, key)) return false;
-    }
-    balance(node);
-    return true;
+template <class T, template<typename ...> class N>
+template <template<typename ...> class M>
+AVLTree<T, N>::AVLTree(BSTree<T, M> &&other) : Base(std::move(other)) {
+    if constexpr (std::is_same<Node, M<T>>::value) root = Base::relink(root, this->nodeCount);
+}
+
+/**
+ * Deep copy of the tree, heights included, in one pass, @see BSTree::clone()
+ * */
+template <class T, template<typename ...> class N>
+AVLTree<T, N> AVLTree<T, N>::clone(unsigned threads) const {
+    AVLTree tree;
+    tree.assign(*this, threads);
+    return tree;
 }
 
 /**
  * Remove a element from the tree
  * @return a pointer to the removed element, or nullptr if it does not exist
+ * @note: the node is unlinked and its predecessor node (if it had two children)
+ *  relinked in its place, so other elements never move to another node
  * */
-template <class T>
-std::unique_ptr<T> AVLTree<T>::remove(T key) {
-    return remove(root, key);
+template <class T, template<typename ...> class N>
+std::unique_ptr<T> AVLTree<T, N>::remove(T key) {
+    Node *node = Base::detach(key);
+    if (node == nullptr) return nullptr;
+    auto keyptr = std::make_unique<T>(std::move(node->key));
+    delete node;
+    return keyptr;
 }
 
 /**
- * @see remove(T key)
- * @note: Removal is done by copy (better for AVLTree -> fewer rotations)
+ * Remove the elements in [lo, hi): the tree is split around the range in
+ * O(log n), the sub-trees holding it deleted in bulk and the rest joined back
+ * @return the number of elements removed
  * */
-template <class T>
-std::unique_ptr<T> AVLTree<T>::remove(Node *&node, T &key) {
-    if (node == nullptr) return nullptr;
-    auto keyptr = std::unique_ptr<T>{nullptr};
-    if (key < node->key) {
-        if (!(keyptr = remove(node->left, key))) return keyptr;
-    } else if (key > node->key) {
-        if (!(keyptr = remove(node->right, key))) return keyptr;
-    } else {  // achou
-        keyptr = std::make_unique<T>(std::move(node->key));
-        if (node->left != nullptr) {
-            Node *max = pullMax(node->left);
-            node->key = max->key;
-            delete max;
-        } else {
-            Node *temp = node->right;
-            delete node;
-            node = temp;
-            return keyptr;  // soh 1 filho, nao precisa balancear
-        }
+template <class T, template<typename ...> class N>
+std::size_t AVLTree<T, N>::eraseRange(const T &lo, const T &hi) {
+    if (!(lo < hi)) return 0;
+    Node *before, *rest, *range, *after;
+    split(root, lo, false, before, rest);
+    split(rest, hi, false, range, after);
+    root = join(before, after);
+    Base::setParent(root, nullptr);
+    std::size_t count = Base::destroy(range);
+    this->nodeCount -= count;
+    if (count > 0) {
+        this->minNode = this->maxNode = nullptr;
+        Base::refreshExtremes();
     }
-    balance(node);
-    return keyptr;
+    return count;
 }
 
 /**
- * Remove the greater element from the tree
- * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * Remove the elements lesser than key (e.g. expire everything older than a time),
+ * splitting them off in O(log n) and deleting them in bulk
+ * @return the number of elements removed
  * */
-template <class T>
-std::unique_ptr<T> AVLTree<T>::removeMax() {
-    if (root == nullptr) return std::unique_ptr<T>{nullptr};
-    Node *&max = Base::findMax(root);
-    return remove(max, max->key);
+template <class T, template<typename ...> class N>
+std::size_t AVLTree<T, N>::eraseBefore(const T &key) {
+    Node *before;
+    split(root, key, false, before, root);
+    Base::setParent(root, nullptr);
+    std::size_t count = Base::destroy(before);
+    this->nodeCount -= count;
+    if (count > 0) {
+        this->minNode = nullptr;
+        Base::refreshExtremes();
+    }
+    return count;
 }
 
 /**
- * Remove the lesser element from the tree
- * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * Remove the elements greater than key, @see eraseBefore(const T &key)
+ * @return the number of elements removed
  * */
-template <class T>
-std::unique_ptr<T> AVLTree<T>::removeMin() {
-    if (root == nullptr) return std::unique_ptr<T>{nullptr};
-    Node *&min = Base::findMin(root);
-    return remove(min, min->key);
+template <class T, template<typename ...> class N>
+std::size_t AVLTree<T, N>::eraseAfter(const T &key) {
+    Node *after;
+    split(root, key, true, root, after);
+    Base::setParent(root, nullptr);
+    std::size_t count = Base::destroy(after);
+    this->nodeCount -= count;
+    if (count > 0) {
+        this->maxNode = nullptr;
+        Base::refreshExtremes();
+    }
+    return count;
 }
 
 /**
- * Remove the node of maximum element but do not destroy it, just extract it from
- * its place and return it, balancing the sub-tree recursively. (used in remove())
- * @see remove(Node *&node, T &key)
+ * Join two AVL sub-trees and a node between them (left < mid < right) in
+ * O(|height difference|): mid takes the place of the first node of the
+ * taller tree's inner spine as short as the other tree, then balance upwards
+ * @return the root of the joined tree
  * */
-template <class T>
-auto AVLTree<T>::pullMax(Node *&node) -> Node* {
-    Node *max;
-    if (node->right != nullptr) {
-        max = pullMax(node->right);
-        balance(node);
+template <class T, template<typename ...> class N>
+auto AVLTree<T, N>::join(Node *left, Node *mid, Node *right) -> Node* {
+    if (height(left) > height(right) + 1) {
+        left->right = join(left->right, mid, right);
+        Base::setParent(left->right, left);
+        balance(left);
+        return left;
+    }
+    if (height(right) > height(left) + 1) {
+        right->left = join(left, mid, right->left);
+        Base::setParent(right->left, right);
+        balance(right);
+        return right;
+    }
+    mid->left = left;
+    mid->right = right;
+    Base::adopt(mid);
+    mid->updateHeight();
+    return mid;
+}
+
+/**
+ * Join two AVL sub-trees (left < right), with the lesser node of right between them
+ * */
+template <class T, template<typename ...> class N>
+auto AVLTree<T, N>::join(Node *left, Node *right) -> Node* {
+    if (left == nullptr) return right;
+    if (right == nullptr) return left;
+    Node *mid = takeMin(right);
+    return join(left, mid, right);
+}
+
+/**
+ * Unlink the lesser node of a sub-tree, balancing it
+ * @return the node
+ * */
+template <class T, template<typename ...> class N>
+auto AVLTree<T, N>::takeMin(Node *&node) -> Node* {
+    if (node->left == nullptr) {
+        Node *min = node;
+        node = node->right;
+        Base::setParent(node, Base::parentOf(min));
+        min->right = nullptr;
+        return min;
+    }
+    Node *min = takeMin(node->left);
+    balance(node);
+    return min;
+}
+
+/**
+ * Split a sub-tree in the elements lesser than key and the others (the ones
+ * equal to key go left if equalLeft), in O(log n): every node on the search
+ * path joins the side of its key with the sub-tree on that side
+ * */
+template <class T, template<typename ...> class N>
+void AVLTree<T, N>::split(Node *node, const T &key, bool equalLeft, Node *&left, Node *&right) {
+    if (node == nullptr) {
+        left = right = nullptr;
+        return;
+    }
+    Node *l = node->left, *r = node->right;
+    if (node->key < key || (equalLeft && !(key < node->key))) {
+        Node *below;
+        split(r, key, equalLeft, below, right);
+        left = join(l, node, below);
     } else {
-        max = node;
-        node = node->left;
+        Node *below;
+        split(l, key, equalLeft, left, below);
+        right = join(below, node, r);
     }
-    return max;
+}
+
+/**
+ * Balance the nodes of path, bottom-up, after a node was attached at its end
+ * or removed below it (insert(T key), remove(T key), removeMin(), ...).
+ * Above path[dirty], stops at the first node whose sub-tree keeps its height
+ * after balancing: nothing changed for its ancestors. An insertion then
+ * stops at its first rotation or soon after, at O(1) amortized nodes.
+ * @return the length of the path prefix above the highest rotation
+ * */
+template <class T, template<typename ...> class N>
+std::size_t AVLTree<T, N>::retrace(Path &path, std::size_t dirty) {
+    std::size_t rotated = path.size();
+#ifdef TREES_STATS
+    ++this->stats.retraces;
+    this->stats.pathNodes += path.size();
+#endif
+    for (std::size_t i = path.size(); i-- > 0; ) {
+#ifdef TREES_STATS
+        ++this->stats.retraced;
+#endif
+        Node *&node = Base::link(path, i);
+        Node *old = node;
+        int height = old->height;
+        balance(node);
+        if (node != old) rotated = i;
+        if (i < dirty && node->height == height) break;
+    }
+    return rotated;
 }
 
 /**
  * Balance the tree if needed
  * */
-template <class T>
-void AVLTree<T>::balance(Node *&node) {
+template <class T, template<typename ...> class N>
+void AVLTree<T, N>::balance(Node *&node) {
     node->updateHeight();
     int bf = bFactor(node);
     if (bf == 2) {
@@ -261,8 +413,8 @@ void AVLTree<T>::balance(Node *&node) {
  * Balance Factor
  * left sub-tree height minus right sub-tree height
  * */
-template <class T>
-inline int AVLTree<T>::bFactor(Node *node) {
+template <class T, template<typename ...> class N>
+inline int AVLTree<T, N>::bFactor(Node *node) {
     return (node->left ? node->left->height : 0)
         - (node->right ? node->right->height : 0);
 }
@@ -270,12 +422,15 @@ inline int AVLTree<T>::bFactor(Node *node) {
 /**
  * Simple left rotation
  * */
-template <class T>
-void AVLTree<T>::rotateLeft(Node *&node) {
+template <class T, template<typename ...> class N>
+void AVLTree<T, N>::rotateLeft(Node *&node) {
     Node *temp = node->right->left;
     node->right->left = node;
     node = node->right;
     node->left->right = temp;
+    Base::setParent(node, Base::parentOf(node->left));
+    Base::setParent(node->left, node);
+    Base::setParent(temp, node->left);
     node->left->updateHeight();
     node->updateHeight();
 }
@@ -283,12 +438,15 @@ void AVLTree<T>::rotateLeft(Node *&node) {
 /**
  * Simple right rotation
  * */
-template <class T>
-void AVLTree<T>::rotateRight(Node *&node) {
+template <class T, template<typename ...> class N>
+void AVLTree<T, N>::rotateRight(Node *&node) {
     Node *temp = node->left->right;
     node->left->right = node;
     node = node->left;
     node->right->left = temp;
+    Base::setParent(node, Base::parentOf(node->right));
+    Base::setParent(node->right, node);
+    Base::setParent(temp, node->right);
     node->right->updateHeight();
     node->updateHeight();
 }
@@ -330,6 +488,7 @@ inline std::ostream& operator<<(std::ostream& os, const AVLTree<T>& avl) {
  * std::cout << inorder(avl);
  * std::cout << preorder(avl);
  * std::cout << postorder(avl);
+ * std::cout << levelorder(avl);
  * */
 namespace trees {
 
@@ -348,6 +507,11 @@ inline std::pair<AVLTree<T>&, eOrder> postorder(AVLTree<T>& avl) {
     return std::make_pair(std::ref(avl), POSTORDER);
 }
 
+template <class T>
+inline std::pair<AVLTree<T>&, eOrder> levelorder(AVLTree<T>& avl) {
+    return std::make_pair(std::ref(avl), LEVELORDER);
+}
+
 template <class T>
 inline std::ostream& operator<<(std::ostream& os, std::pair<AVLTree<T>&, eOrder> p) {
     return p.first.print(os, p.second);
@@ -34,6 +34,11 @@ IN THE SOFTWARE.
  * bst.remove(t1);  // ou bst.remove(t1, FUSION)
  * T *t = bst.get(t2);
  * bst.print(cout, INORDER)  // ou cout << bst;
+ * bst.setPrefetch(PREFETCH_CHILDREN);  // trees much larger than the cache
+ * BSTree<T, ParentBSTNode> linked;  // nodes also linked to their parent
+ * BSTree<T, AVLNode> load;  // unbalanced, but AVLTree<T>(std::move(load)) relinks its nodes
+ * BSTree<T> copy = bst.clone(4);  // deep copy, 4 threads (or BSTree<T> copy(bst))
+ * for (const T& t : linked.scan()) ...  // stackless in-order traversal
  *
  * */
 
@@ -43,6 +48,14 @@ IN THE SOFTWARE.
 #include <memory>
 #include <utility>
 #include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <cmath>
+#include <future>
 #include "TreeBase.hpp"
 
 
@@ -78,11 +91,21 @@ struct BSTNode : public base::BSTNode<T, BSTNode> {
 };
 
 
+/** BSTNode linked to its parent too, for stackless iteration (scan()) */
+template <class T>
+struct ParentBSTNode : public base::BSTNode<T, ParentBSTNode> {
+    ParentBSTNode *parent = nullptr;
+    using base::BSTNode<T, ParentBSTNode>::BSTNode;
+    ~ParentBSTNode() {}
+};
+
+
 /** Reading modes */
 enum eOrder {
     INORDER,
     PREORDER,
-    POSTORDER
+    POSTORDER,
+    LEVELORDER
 };
 
 /** Removal modes */
@@ -91,6 +114,20 @@ enum eRemove {
     FUSION
 };
 
+/** Answers of a visitor, @see BSTree::visit() */
+enum eVisit {
+    CONTINUE,  // go on with the traversal
+    SKIP,      // do not visit what is left of this node's sub-trees
+    STOP       // end the traversal
+};
+
+/** Prefetching modes for the descent from root (get, insert, remove) */
+enum ePrefetch {
+    NO_PREFETCH,            // default
+    PREFETCH_CHILDREN,      // both children of the node being compared
+    PREFETCH_GRANDCHILDREN  // the four grandchildren (children already requested one level up)
+};
+
 
 /* ^^^^^^^^^^^^^^^^^^
  * Binary Search Tree
@@ -101,40 +138,245 @@ class BSTree : public base::Tree<T, N> {
 
  public:
     using Node = N<T>;  // aliases for the node type
+    using Path = base::Stack<Node*, 64>;  // nodes from root down to a position
+    static constexpr std::size_t BATCH_GROUP = 16;  // lookups interleaved by getBatch()
+    static constexpr std::size_t LOOKAHEAD = 16;  // largest window of scanAhead()
+
+    /**
+     * In-order iterator over the keys, holding the path from root to its node.
+     * Any change to the tree invalidates it, except the insert(iterator hint, T key)
+     * that returns it.
+     * */
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        reference operator*() const { return path.back()->key; }
+        pointer operator->() const { return &path.back()->key; }
+        iterator& operator++();
+        iterator operator++(int) { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator& other) const { return node() == other.node(); }
+        bool operator!=(const iterator& other) const { return node() != other.node(); }
+
+     private:
+        friend class BSTree;
+        Node* node() const { return path.empty() ? nullptr : path.back(); }
+        Path path;  // empty for end()
+    };
+
+    /**
+     * In-order iterator for node layouts with parent links (ParentBSTNode,
+     * ParentAVLNode): a single node pointer, steps climb the parent links
+     * instead of keeping a path, in O(1) space and O(1) amortized time.
+     * Stays valid while its element is in the tree. end() can not be decremented.
+     * */
+    class scan_iterator {
+     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        scan_iterator() {}
+        reference operator*() const { return node->key; }
+        pointer operator->() const { return &node->key; }
+        scan_iterator& operator++() { node = successor(node); return *this; }
+        scan_iterator& operator--() { node = predecessor(node); return *this; }
+        scan_iterator operator++(int) { scan_iterator it = *this; ++*this; return it; }
+        scan_iterator operator--(int) { scan_iterator it = *this; --*this; return it; }
+        bool operator==(const scan_iterator& other) const { return node == other.node; }
+        bool operator!=(const scan_iterator& other) const { return node != other.node; }
+
+     private:
+        friend class BSTree;
+        explicit scan_iterator(Node *node) : node(node) {}
+        Node *node = nullptr;  // nullptr for the end
+    };
+
+    /**
+     * In-order iterator that walks a window of nodes ahead of its position,
+     * prefetching their keys' out-of-line data (base::prefetchKey()), and the
+     * right child of every node it descends through, so the successor steps
+     * find their nodes already on the way. Any change to the tree invalidates it.
+     * */
+    class lookahead_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        lookahead_iterator() {}
+        reference operator*() const { return window[head]->key; }
+        pointer operator->() const { return &window[head]->key; }
+        lookahead_iterator& operator++();
+        bool operator==(const lookahead_iterator& other) const { return node() == other.node(); }
+        bool operator!=(const lookahead_iterator& other) const { return node() != other.node(); }
+
+     private:
+        friend class BSTree;
+        lookahead_iterator(Node *root, std::size_t size);
+        Node* node() const { return count ? window[head] : nullptr; }
+        void descend(Node *node);
+        void advance();  // the runner, one node ahead of the window
+        Path path;  // root to the runner's node
+        Node *window[LOOKAHEAD];  // ring of the next nodes, from head
+        std::size_t head = 0, count = 0;
+    };
+
+    /**
+     * Lazy traversal in any eOrder, one node per step: a state machine over
+     * the path from root to its node (in/pre/postorder) or over the current
+     * and next tree levels (level-order), so nothing is allocated per element.
+     * Any change to the tree invalidates it.
+     * */
+    class order_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        order_iterator() {}
+        reference operator*() const { return node()->key; }
+        pointer operator->() const { return &node()->key; }
+        order_iterator& operator++();
+        order_iterator operator++(int) { order_iterator it = *this; ++*this; return it; }
+        bool operator==(const order_iterator& other) const { return node() == other.node(); }
+        bool operator!=(const order_iterator& other) const { return node() != other.node(); }
+
+     private:
+        friend class BSTree;
+        order_iterator(Node *root, eOrder order);
+        Node* node() const;
+        void descend(Node *node);  // to the first node of a sub-tree in the order
+        eOrder order = INORDER;
+        Path path;  // root to the current node (in/pre/postorder)
+        std::vector<Node*> level, next;  // level-order: current level and the one below
+        std::size_t at = 0;  // level-order: current node in level
+    };
 
     BSTree() : Base() {}
+    BSTree(const BSTree &other) : Base() { assign(other, 1); }
+    BSTree(BSTree &&other) noexcept : Base() { take(other); }
+    template <template<typename ...> class M> explicit BSTree(BSTree<T, M> &&other);
     virtual ~BSTree() { destroy(root); }
+    BSTree& operator=(const BSTree &other);
+    BSTree& operator=(BSTree &&other) noexcept;
 
     /* External Methods */
     // bool Tree::isEmpty() const;
     void clear() override;
+    BSTree clone(unsigned threads = 1) const;
     T* get(T key) const override;
     T* getMax() const;
     T* getMin() const;
+    void getBatch(const T *keys, std::size_t count, T **out) const;
+    void getBatch(const std::vector<T>& keys, std::vector<T*>& out) const;
+    std::size_t getSortedBatch(const T *keys, std::size_t count, T **out) const;
+    bool containsSorted(const T *keys, std::size_t count) const;
     bool insert(T key) override;
+    std::pair<iterator, bool> insert(iterator hint, T key);
+    iterator begin() const;
+    iterator end() const { return iterator(); }
+    iterator find(T key) const;
+    iterator findFrom(iterator from, T key) const;
+    base::Range<scan_iterator> scan() const;
+    base::Range<lookahead_iterator> scanAhead(std::size_t window = 8) const;
+    base::Range<order_iterator> traverse(eOrder order = INORDER) const;
+    template <class Visitor> bool visit(eOrder order, Visitor&& visitor) const;
+    scan_iterator scanFind(T key) const;
     std::unique_ptr<T> remove(T key) override;
     std::unique_ptr<T> remove(T key, eRemove mode);
     virtual std::unique_ptr<T> removeMax();
     virtual std::unique_ptr<T> removeMin();
     std::ostream& print(std::ostream& os, eOrder order = INORDER) const;
+    void setPrefetch(ePrefetch mode) { prefetching = mode; }
+    ePrefetch getPrefetch() const { return prefetching; }
+    std::size_t size() const { return nodeCount; }
+    void rebalance();
+    void setAutoRebalance(double factor) { rebalanceFactor = factor; }
+    double getAutoRebalance() const { return rebalanceFactor; }
+#ifdef TREES_STATS
+    /** Work of retrace(): calls, nodes a full retrace would visit, nodes it visited */
+    struct Stats { unsigned long long retraces = 0, pathNodes = 0, retraced = 0; } stats;
+#endif
 
     template <class _T> friend BSTree<_T>& operator<<(BSTree<_T>& bst, _T key);
     template <class _T> friend std::ostream& operator<<(std::ostream& os, const BSTree<_T>& bst);
 
  protected:
     using Base::root;
+    ePrefetch prefetching = NO_PREFETCH;
+    double rebalanceFactor = 0;  // insert() rebuilds when depth > factor * log2(size), 0: never
+    Node *minNode = nullptr;  // cached extremes, kept by newNode()/deleteNode()
+    Node *maxNode = nullptr;
+    std::size_t nodeCount = 0;  // kept with the extremes
 
     /* Internal recursive Methods */
-    void destroy(Node *root);
-    T* get(Node *node, T &key) const;
-    virtual bool insert(Node *&node, T &key);
+    std::size_t destroy(Node *root);
+    T* get(Node *node, T &key, std::uint64_t prefix) const;
+    std::size_t getSorted(Node *node, const T *keys, std::size_t count, T **out) const;
+    bool containsSorted(const Node *node, const T *keys, std::size_t count) const;
     std::unique_ptr<T> removeByCopy(Node *&node, T &key);
     std::unique_ptr<T> removeByFusion(Node *&node, T &key);
     Node*& findMax(Node *&root);
     Node*& findMin(Node *&root);
+    Node* newNode(T &key);
+    void deleteNode(Node *node);
+    void track(Node *node);
+    void untrack(Node *node);
+    void refreshExtremes();
+    std::unique_ptr<T> removeExtreme(bool greatest);
     void inorder(std::ostream& os, const Node *node) const;
     void preorder(std::ostream& os, const Node *node) const;
     void postorder(std::ostream& os, const Node *node) const;
+    template <class Visitor> eVisit visit(const Node *node, eOrder order, Visitor &visitor) const;
+    template <class Visitor> static eVisit call(Visitor &visitor, const Node &node);
+    void prefetch(const Node *node) const;
+
+    /* Copy and move */
+    void assign(const BSTree &other, unsigned threads);
+    void take(BSTree &other);
+    static Node* copy(const Node *node, Node *parent, unsigned threads);
+    static Node* copyNode(const Node *node, Node *parent);
+
+    /* Day-Stout-Warren rebuild, in place */
+    void rebuild(Node *&node, std::size_t size, Node *parent);
+    void rebuildAbove(Path &path);
+    static void toVine(Node *&node);
+    static void compress(Node *&node, std::size_t count);
+    static void restore(Node *node, Node *parent);
+    static std::size_t countNodes(const Node *node);
+    template <template<typename ...> class M> static Node* relink(M<T> *node, std::size_t size);
+    template <class Source> static Node* build(Source *&vine, std::size_t size);
+
+    /* Parent links, for node layouts that have them (no-op otherwise) */
+    static constexpr bool PARENT_LINKS = base::hasParent<Node>::value;
+    static void setParent(Node *child, Node *parent);
+    static void adopt(Node *node);
+    static Node* parentOf(const Node *node);
+    static Node* successor(Node *node);
+    static Node* predecessor(Node *node);
+
+    /* Internal path Methods */
+    bool seek(Path &path, const T &key) const;
+    Node*& link(Path &path, std::size_t i);
+    virtual std::size_t retrace(Path &path, std::size_t dirty);
+    std::size_t append(Path &path, Node *node);
+    static Path& pathOf(iterator &it) { return it.path; }
+    bool attach(Node *node);
+    Node* detach(const T &key);
+    Node* detachExtreme(bool greatest);
+
+    template <class, template<typename ...> class> friend class BSTree;
 };
 
 
@@ -146,26 +388,86 @@ class BSTree : public base::Tree<T, N> {
  * >> BSTree implementation <<
  * */
 
-/** 
+/**
+ * Take the elements and settings of another tree, leaving it empty. With the
+ * same node layout (e.g. from an AVLTree<T, N>) the nodes are taken as they are,
+ * without allocating; otherwise each key moves to a new node of a balanced tree
+ * built in one in-order pass, @see relink()
+ * */
+template <class T, template<typename ...> class N>
+template <template<typename ...> class M>
+BSTree<T, N>::BSTree(BSTree<T, M> &&other) : Base() {
+    if constexpr (std::is_same<Node, M<T>>::value) {
+        take(other);
+    } else {
+        root = relink(other.root, other.nodeCount);
+        nodeCount = other.nodeCount;
+        prefetching = other.prefetching;
+        rebalanceFactor = other.rebalanceFactor;
+        refreshExtremes();
+        other.root = other.minNode = other.maxNode = nullptr;
+        other.nodeCount = 0;
+    }
+}
+
+/**
+ * Replace the elements by a deep copy of another tree's, @see clone()
+ * */
+template <class T, template<typename ...> class N>
+BSTree<T, N>& BSTree<T, N>::operator=(const BSTree &other) {
+    if (this != &other) {
+        clear();
+        assign(other, 1);
+    }
+    return *this;
+}
+
+/**
+ * Replace the elements by another tree's, in O(1), leaving it empty
+ * */
+template <class T, template<typename ...> class N>
+BSTree<T, N>& BSTree<T, N>::operator=(BSTree &&other) noexcept {
+    if (this != &other) {
+        clear();
+        take(other);
+    }
+    return *this;
+}
+
+/**
  * Clear the tree, deleting all nodes
  * */
 template <class T, template<typename ...> class N>
 void BSTree<T, N>::clear() {
     destroy(root);
-    root = nullptr;
+    root = minNode = maxNode = nullptr;
+    nodeCount = 0;
+}
+
+/**
+ * Deep copy of the tree, with the same shape, in one pass: no comparison and
+ * no rebalancing, one node allocated per element
+ * @param threads: with more than one, the sub-trees of the top levels are
+ *  copied concurrently (std::async), worth it for trees of millions of nodes
+ * */
+template <class T, template<typename ...> class N>
+BSTree<T, N> BSTree<T, N>::clone(unsigned threads) const {
+    BSTree tree;
+    tree.assign(*this, threads);
+    return tree;
 }
 
 /**
  * Delete a node and its sub-trees
  * @see clear()
+ * @return the number of nodes deleted
  * */
 template <class T, template<typename ...> class N>
-void BSTree<T, N>::destroy(Node *root) {
-    if (root != nullptr) {
-        destroy(root->left);
-        destroy(root->right);
-        delete root;
-    }
+std::size_t BSTree<T, N>::destroy(Node *root) {
+    if (root == nullptr) return 0;
+    std::size_t count = destroy(root->left) + destroy(root->right);
+    delete root;
+    return count + 1;
 }
 
 /**
@@ -174,67 +476,790 @@ void BSTree<T, N>::destroy(Node *root) {
  * */
 template <class T, template<typename ...> class N>
 T* BSTree<T, N>::get(T key) const {
-    return get(root, key);
+    return get(root, key, base::KeyPrefix<T>::of(key));
 }
 
 /**
  * @see get(T key)
  * */
 template <class T, template<typename ...> class N>
-T* BSTree<T, N>::get(Node *node, T &key) const {
+T* BSTree<T, N>::get(Node *node, T &key, std::uint64_t prefix) const {
     if (node == nullptr) return nullptr;
-    if (key < node->key) return get(node->left, key);
-    if (key > node->key) return get(node->right, key);
+    prefetch(node);
+    const int cmp = base::compare(key, prefix, *node);
+    if (cmp < 0) return get(node->left, key, prefix);
+    if (cmp > 0) return get(node->right, key, prefix);
     return &node->key;
 }
 
 /**
- * Search for the greater element in the tree
+ * Search for many independent keys at once: out[i] receives get(keys[i]).
+ * Lookups walk down in lock-step, BATCH_GROUP at a time, one level per round,
+ * prefetching the next node of each one, so the cache misses of a whole
+ * group are in flight together instead of one after the other.
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::getBatch(const T *keys, std::size_t count, T **out) const {
+    Node *cursor[BATCH_GROUP];
+    std::uint64_t prefix[BATCH_GROUP];
+    for (std::size_t first = 0; first < count; first += BATCH_GROUP) {
+        std::size_t size = count - first < BATCH_GROUP ? count - first : BATCH_GROUP;
+        for (std::size_t i = 0; i < size; ++i) {
+            cursor[i] = root;
+            prefix[i] = base::KeyPrefix<T>::of(keys[first + i]);
+            out[first + i] = nullptr;
+        }
+        for (std::size_t active = size; active > 0; ) {
+            active = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                Node *node = cursor[i];
+                if (node == nullptr) continue;
+                const int cmp = base::compare(keys[first + i], prefix[i], *node);
+                if (cmp < 0) {
+                    node = node->left;
+                } else if (cmp > 0) {
+                    node = node->right;
+                } else {
+                    out[first + i] = &node->key;
+                    node = nullptr;
+                }
+                if (node != nullptr) {
+                    base::prefetch(node);
+                    ++active;
+                }
+                cursor[i] = node;
+            }
+        }
+    }
+}
+
+/**
+ * @see getBatch(const T *keys, std::size_t count, T **out)
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::getBatch(const std::vector<T>& keys, std::vector<T*>& out) const {
+    out.resize(keys.size());
+    getBatch(keys.data(), keys.size(), out.data());
+}
+
+/**
+ * Search for a sorted (ascending) set of keys in a single traversal: the
+ * keys are partitioned around each node and each part only descends into
+ * the matching sub-tree, so the shared path prefixes are walked once.
+ * out[i] receives get(keys[i])
+ * @return the number of keys found
+ * */
+template <class T, template<typename ...> class N>
+std::size_t BSTree<T, N>::getSortedBatch(const T *keys, std::size_t count, T **out) const {
+    return getSorted(root, keys, count, out);
+}
+
+/**
+ * @see getSortedBatch(const T *keys, std::size_t count, T **out)
+ * */
+template <class T, template<typename ...> class N>
+std::size_t BSTree<T, N>::getSorted(Node *node, const T *keys, std::size_t count, T **out) const {
+    if (count == 0) return 0;
+    if (node == nullptr) {
+        std::fill(out, out + count, nullptr);
+        return 0;
+    }
+    std::size_t mid = std::lower_bound(keys, keys + count, node->key) - keys;
+    std::size_t found = getSorted(node->left, keys, mid, out);
+    for (; mid < count && !(node->key < keys[mid]); ++mid, ++found)
+        out[mid] = &node->key;
+    return found + getSorted(node->right, keys + mid, count - mid, out + mid);
+}
+
+/**
+ * Check if all keys of a sorted (ascending) set are in the tree,
+ * in a single traversal that stops at the first missing key
+ * @see getSortedBatch(const T *keys, std::size_t count, T **out)
+ * */
+template <class T, template<typename ...> class N>
+bool BSTree<T, N>::containsSorted(const T *keys, std::size_t count) const {
+    return containsSorted(root, keys, count);
+}
+
+/**
+ * @see containsSorted(const T *keys, std::size_t count)
+ * */
+template <class T, template<typename ...> class N>
+bool BSTree<T, N>::containsSorted(const Node *node, const T *keys, std::size_t count) const {
+    if (count == 0) return true;
+    if (node == nullptr) return false;
+    std::size_t mid = std::lower_bound(keys, keys + count, node->key) - keys;
+    if (!containsSorted(node->left, keys, mid)) return false;
+    while (mid < count && !(node->key < keys[mid])) ++mid;
+    return containsSorted(node->right, keys + mid, count - mid);
+}
+
+/**
+ * The greater element in the tree, in O(1) (cached)
  * @return a pointer to the element, or nullptr if it does not exist (empty tree)
  * */
 template <class T, template<typename ...> class N>
 T* BSTree<T, N>::getMax() const {
-    if (root == nullptr) return nullptr;
-    Node *max = root;
-    while (max->right != nullptr)
-        max = max->right;
-    return &max->key;
+    return maxNode ? &maxNode->key : nullptr;
 }
 
 /**
- * Search for the lesser element in the tree
+ * The lesser element in the tree, in O(1) (cached)
  * @return a pointer to the element, or nullptr if it does not exist (empty tree)
  * */
 template <class T, template<typename ...> class N>
 T* BSTree<T, N>::getMin() const {
-    if (root == nullptr) return nullptr;
-    Node *min = root;
-    while (min->left != nullptr)
-        min = min->left;
-    return &min->key;
+    return minNode ? &minNode->key : nullptr;
 }
 
 /**
- * Insert a element in the tree
+ * Insert a element in the tree. With setAutoRebalance(c), an insertion deeper
+ * than c * log2(size) rebuilds the sub-tree where the tree got unbalanced.
  * @return true if element was inserted succefully, or false if it already exists
  * */
 template <class T, template<typename ...> class N>
 bool BSTree<T, N>::insert(T key) {
-    return insert(root, key);
+    Path path;
+    if (seek(path, key)) return false;
+    append(path, newNode(key));
+    if (rebalanceFactor > 0 && path.size() - 1 > rebalanceFactor * std::log2(nodeCount))
+        rebuildAbove(path);
+    return true;
 }
 
 /**
- * @see insert(T key)
+ * Insert a element starting the search from a position close to it
+ * (e.g. the previous insertion for increasing keys), instead of from root.
+ * Rebuilds a sub-tree with setAutoRebalance(c) as insert(T key) does.
+ * @return the position of the element and true if it was inserted, or false if it already exists
+ * @see findFrom(iterator from, T key)
  * */
 template <class T, template<typename ...> class N>
-bool BSTree<T, N>::insert(Node *&node, T &key) {
-    if (node == nullptr) {
-        node = new Node(key);
-        return true;
+auto BSTree<T, N>::insert(iterator hint, T key) -> std::pair<iterator, bool> {
+    Path &path = hint.path;
+    if (seek(path, key)) return std::make_pair(hint, false);
+    std::size_t valid = append(path, newNode(key));
+    if (valid < path.size()) {  // rotated: path below 'valid' is stale
+        path.resize(valid);
+        seek(path, key);
     }
-    if (key < node->key) return insert(node->left, key);
-    if (key > node->key) return insert(node->right, key);
-    return false;
+    if (rebalanceFactor > 0 && path.size() - 1 > rebalanceFactor * std::log2(nodeCount)) {
+        rebuildAbove(path);
+        path.clear();  // rebuilt below the scapegoat, maybe retraced above it
+        seek(path, key);
+    }
+    return std::make_pair(hint, true);
+}
+
+/**
+ * Position of the lesser element, end() if the tree is empty
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::begin() const -> iterator {
+    iterator it;
+    for (Node *node = root; node != nullptr; node = node->left)
+        it.path.push_back(node);
+    return it;
+}
+
+/**
+ * Search for a element, from root
+ * @return its position, or end() if it does not exist
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::find(T key) const -> iterator {
+    iterator it;
+    return seek(it.path, key) ? it : end();
+}
+
+/**
+ * Search for a element starting from a known position (finger search):
+ * climbs from 'from' only until the sub-tree that must hold the key,
+ * so keys close to 'from' are found without a descent from root
+ * @return its position, or end() if it does not exist
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::findFrom(iterator from, T key) const -> iterator {
+    return seek(from.path, key) ? from : end();
+}
+
+/**
+ * Stackless in-order traversal, for node layouts with parent links
+ * @example: for (const T& key : bst.scan()) ...
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::scan() const -> base::Range<scan_iterator> {
+    static_assert(PARENT_LINKS, "scan() needs a node layout with parent links");
+    return {scan_iterator(minNode), scan_iterator()};
+}
+
+/**
+ * Search for a element, from root, for a stackless traversal from it
+ * @return its position, or the end of scan() if it does not exist
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::scanFind(T key) const -> scan_iterator {
+    static_assert(PARENT_LINKS, "scanFind() needs a node layout with parent links");
+    Node *node = root;
+    while (node != nullptr && (key < node->key || node->key < key))
+        node = key < node->key ? node->left : node->right;
+    return scan_iterator(node);
+}
+
+/**
+ * In-order traversal that prefetches a window of upcoming nodes ahead
+ * of the consumer (up to LOOKAHEAD), for scans bound by pointer chasing
+ * @example: for (const T& key : avl.scanAhead(8)) ...
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::scanAhead(std::size_t window) const -> base::Range<lookahead_iterator> {
+    return {lookahead_iterator(root, std::min(std::max<std::size_t>(window, 1), LOOKAHEAD)),
+            lookahead_iterator()};
+}
+
+/**
+ * (lookahead_iterator) Fill the window with the first nodes in order
+ * */
+template <class T, template<typename ...> class N>
+BSTree<T, N>::lookahead_iterator::lookahead_iterator(Node *root, std::size_t size) {
+    if (root != nullptr) descend(root);
+    while (count < size && !path.empty()) advance();
+}
+
+/**
+ * (lookahead_iterator) Push the left spine of a sub-tree on the runner's
+ * path, starting to load the right children it will step to later
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::lookahead_iterator::descend(Node *node) {
+    for (; node != nullptr; node = node->left) {
+        base::prefetch(node->right);
+        path.push_back(node);
+    }
+}
+
+/**
+ * (lookahead_iterator) Move the runner's node into the window and step the runner
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::lookahead_iterator::advance() {
+    Node *node = path.back();
+    base::prefetchKey(node->key);
+    window[(head + count++) % LOOKAHEAD] = node;
+    if (node->right != nullptr) {
+        descend(node->right);
+        return;
+    }
+    do {
+        node = path.back();
+        path.pop_back();
+    } while (!path.empty() && path.back()->right == node);
+}
+
+/**
+ * (lookahead_iterator) Next element in order
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::lookahead_iterator::operator++() -> lookahead_iterator& {
+    head = (head + 1) % LOOKAHEAD;
+    --count;
+    if (!path.empty()) advance();
+    return *this;
+}
+
+/**
+ * Lazy traversal in a given order, for range-based for loops that may stop early
+ * @example: for (const T& key : bst.traverse(LEVELORDER)) if (...) break;
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::traverse(eOrder order) const -> base::Range<order_iterator> {
+    return {order_iterator(root, order), order_iterator()};
+}
+
+/**
+ * (order_iterator) Start at the first node of the tree in order
+ * */
+template <class T, template<typename ...> class N>
+BSTree<T, N>::order_iterator::order_iterator(Node *root, eOrder order) : order(order) {
+    if (root == nullptr) return;
+    if (order == LEVELORDER) {
+        level.push_back(root);
+    } else {
+        descend(root);
+    }
+}
+
+/**
+ * (order_iterator) Current node, nullptr at the end
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::order_iterator::node() const -> Node* {
+    if (order == LEVELORDER) return at < level.size() ? level[at] : nullptr;
+    return path.empty() ? nullptr : path.back();
+}
+
+/**
+ * (order_iterator) Push the path down to the first node of a sub-tree:
+ * itself in preorder, its leftmost node in inorder, its first leaf in postorder
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::order_iterator::descend(Node *node) {
+    path.push_back(node);
+    if (order == PREORDER) return;
+    for (;;) {
+        if (node->left != nullptr) {
+            node = node->left;
+        } else if (order == POSTORDER && node->right != nullptr) {
+            node = node->right;
+        } else {
+            return;
+        }
+        path.push_back(node);
+    }
+}
+
+/**
+ * (order_iterator) Next node in its order
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::order_iterator::operator++() -> order_iterator& {
+    Node *current = node();
+    switch (order) {
+        case INORDER:
+            if (current->right != nullptr) {
+                descend(current->right);
+                break;
+            }
+            do {
+                current = path.back();
+                path.pop_back();
+            } while (!path.empty() && path.back()->right == current);
+            break;
+        case PREORDER:
+            if (current->left != nullptr || current->right != nullptr) {
+                path.push_back(current->left ? current->left : current->right);
+                break;
+            }
+            // climb to the first ancestor left from its left side that has a right sub-tree
+            for (path.pop_back(); !path.empty(); current = path.back(), path.pop_back()) {
+                Node *up = path.back();
+                if (up->left == current && up->right != nullptr) {
+                    path.push_back(up->right);
+                    break;
+                }
+            }
+            break;
+        case POSTORDER:
+            path.pop_back();
+            if (!path.empty() && path.back()->left == current && path.back()->right != nullptr)
+                descend(path.back()->right);
+            break;
+        case LEVELORDER:
+            if (current->left != nullptr) next.push_back(current->left);
+            if (current->right != nullptr) next.push_back(current->right);
+            if (++at == level.size()) {
+                level.swap(next);
+                next.clear();
+                at = 0;
+            }
+            break;
+    }
+    return *this;
+}
+
+/**
+ * Next element in order
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::iterator::operator++() -> iterator& {
+    Node *node = path.back();
+    if (node->right != nullptr) {
+        for (node = node->right; node != nullptr; node = node->left)
+            path.push_back(node);
+    } else {
+        do {
+            node = path.back();
+            path.pop_back();
+        } while (!path.empty() && path.back()->right == node);
+    }
+    return *this;
+}
+
+/**
+ * Move a path to the node holding key, or else to the node under which it
+ * would be inserted. Climbs from the end of the path only past the ancestors
+ * whose sub-tree cannot hold key, then descends (an empty path starts at root).
+ * @return true if key was found at path.back()
+ * */
+template <class T, template<typename ...> class N>
+bool BSTree<T, N>::seek(Path &path, const T &key) const {
+    if (!path.empty()) {
+        const bool right = path.back()->key < key;
+        if (!right && !(key < path.back()->key)) return true;
+        // the sub-trees on a path are bounded, on the side we move to,
+        // by the nearest ancestor reached through the opposite turn
+        std::size_t bottom = path.size() - 1;
+        for (std::size_t i = bottom; i > 0; --i) {
+            Node *parent = path[i - 1];
+            if ((right ? parent->left : parent->right) != path[i]) continue;
+            if (right ? key < parent->key : parent->key < key) break;
+            bottom = i - 1;
+            if (!(key < parent->key) && !(parent->key < key)) break;
+        }
+        path.resize(bottom + 1);
+    } else if (root != nullptr) {
+        path.push_back(root);
+    } else {
+        return false;
+    }
+    const std::uint64_t prefix = base::KeyPrefix<T>::of(key);
+    for (;;) {
+        Node *node = path.back();
+        prefetch(node);
+        const int cmp = base::compare(key, prefix, *node);
+        if (cmp == 0) return true;
+        Node *next = cmp < 0 ? node->left : node->right;
+        if (next == nullptr) return false;
+        path.push_back(next);
+    }
+}
+
+/**
+ * Reference to the pointer that links path[i] to the tree (root or a parent's child)
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::link(Path &path, std::size_t i) -> Node*& {
+    if (i == 0) return root;
+    return path[i - 1]->left == path[i] ? path[i - 1]->left : path[i - 1]->right;
+}
+
+/**
+ * Fill an empty tree with a deep copy of another's nodes and settings
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::assign(const BSTree &other, unsigned threads) {
+    root = copy(other.root, nullptr, threads);
+    nodeCount = other.nodeCount;
+    prefetching = other.prefetching;
+    rebalanceFactor = other.rebalanceFactor;
+    refreshExtremes();
+}
+
+/**
+ * Take the nodes and settings of another tree of the same layout as they are, leaving it empty
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::take(BSTree &other) {
+    root = other.root;
+    minNode = other.minNode;
+    maxNode = other.maxNode;
+    nodeCount = other.nodeCount;
+    prefetching = other.prefetching;
+    rebalanceFactor = other.rebalanceFactor;
+    other.root = other.minNode = other.maxNode = nullptr;
+    other.nodeCount = 0;
+}
+
+/**
+ * Copy a sub-tree node by node (keys, heights, shape), without recursion since
+ * it may be degenerate; with threads > 1 the left sub-tree of each top node
+ * is copied by another thread, down to one thread per sub-tree
+ * @return the root of the copy
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::copy(const Node *node, Node *parent, unsigned threads) -> Node* {
+    if (node == nullptr) return nullptr;
+    Node *top = copyNode(node, parent);
+    if (threads > 1) {
+        auto left = std::async(std::launch::async, [=] {
+            return copy(node->left, top, threads / 2);
+        });
+        top->right = copy(node->right, top, threads - threads / 2);
+        top->left = left.get();
+        return top;
+    }
+    base::Stack<std::pair<const Node*, Node*>, 64> pending;  // copied nodes with children to copy
+    pending.push_back(std::make_pair(node, top));
+    while (!pending.empty()) {
+        const Node *from = pending.back().first;
+        Node *to = pending.back().second;
+        pending.pop_back();
+        if (from->right != nullptr) {
+            to->right = copyNode(from->right, to);
+            pending.push_back(std::make_pair(from->right, to->right));
+        }
+        if (from->left != nullptr) {
+            to->left = copyNode(from->left, to);
+            pending.push_back(std::make_pair(from->left, to->left));
+        }
+    }
+    return top;
+}
+
+/**
+ * New unlinked copy of a node (key and any height), under parent
+ * */
+template <class T, template<typename ...> class N>
+inline auto BSTree<T, N>::copyNode(const Node *node, Node *parent) -> Node* {
+    Node *copy = new Node(*node);
+    copy->left = copy->right = nullptr;
+    setParent(copy, parent);
+    return copy;
+}
+
+/**
+ * Reshape the whole tree into a perfectly balanced one (Day-Stout-Warren):
+ * O(n) time, O(1) extra space, the same nodes relinked, nothing allocated
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::rebalance() {
+    rebuild(root, nodeCount, nullptr);
+}
+
+/**
+ * Rebuild a sub-tree of size nodes in place: rotate it right into a vine
+ * (a list down the right children), then compress the vine by left rotations
+ * of every other node, first the leftover of the last level, then halving
+ * @param parent: the parent of the sub-tree, for node layouts with parent links
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::rebuild(Node *&node, std::size_t size, Node *parent) {
+    if (size < 2) return;
+    toVine(node);
+    std::size_t full = 1;  // nodes of the largest perfect tree that fits: 2^k - 1
+    while (2 * full + 1 <= size) full = 2 * full + 1;
+    compress(node, size - full);
+    for (size = full; size > 1; size /= 2) compress(node, size / 2);
+    restore(node, parent);
+}
+
+/**
+ * After an insertion at the end of path that went too deep, find the lowest
+ * ancestor (scapegoat) whose sub-tree is deeper than factor * log2(its size)
+ * and rebuild it only, then let the tree retrace the path above it.
+ * Amortized O(log n) per insertion.
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::rebuildAbove(Path &path) {
+    const std::size_t bottom = path.size() - 1;
+    std::size_t size = 1;  // of the sub-tree of path[i + 1]
+    for (std::size_t i = bottom; i-- > 0; ) {
+        Node *node = path[i];
+        size += 1 + countNodes(node->left == path[i + 1] ? node->right : node->left);
+        if (bottom - i > rebalanceFactor * std::log2(size)) {
+            Node *&place = link(path, i);
+            rebuild(place, size, i > 0 ? path[i - 1] : nullptr);
+            path.resize(i + 1);
+            path[i] = place;
+            retrace(path, i);
+            return;
+        }
+    }
+}
+
+/**
+ * Rotate right every node with a left child, until the sub-tree is a vine
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::toVine(Node *&node) {
+    for (Node **place = &node; *place != nullptr; ) {
+        Node *top = *place;
+        if (top->left != nullptr) {
+            Node *left = top->left;
+            top->left = left->right;
+            left->right = top;
+            *place = left;
+        } else {
+            place = &top->right;
+        }
+    }
+}
+
+/**
+ * Rotate left count nodes down the right spine, every other one
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::compress(Node *&node, std::size_t count) {
+    Node **place = &node;
+    for (std::size_t i = 0; i < count; ++i) {
+        Node *top = *place;
+        Node *right = top->right;
+        top->right = right->left;
+        right->left = top;
+        *place = right;
+        place = &right->right;
+    }
+}
+
+/**
+ * Set the parent links and heights of a rebuilt sub-tree, in node layouts that have them
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::restore(Node *node, Node *parent) {
+    if constexpr (PARENT_LINKS || base::hasHeight<Node>::value) {
+        if (node == nullptr) return;
+        setParent(node, parent);
+        restore(node->left, node);
+        restore(node->right, node);
+        if constexpr (base::hasHeight<Node>::value) node->updateHeight();
+    }
+}
+
+/**
+ * Number of nodes of a sub-tree, without recursion (it may be degenerate)
+ * */
+template <class T, template<typename ...> class N>
+std::size_t BSTree<T, N>::countNodes(const Node *node) {
+    std::size_t count = 0;
+    base::Stack<const Node*, 64> pending;
+    if (node != nullptr) pending.push_back(node);
+    while (!pending.empty()) {
+        node = pending.back();
+        pending.pop_back();
+        ++count;
+        if (node->left != nullptr) pending.push_back(node->left);
+        if (node->right != nullptr) pending.push_back(node->right);
+    }
+    return count;
+}
+
+/**
+ * Relink a whole tree of size nodes, of this node layout or another, into a
+ * perfectly balanced tree with its parent links and heights set: fold it into
+ * a vine, then build() in one in-order pass down the vine. O(n), O(log n) stack
+ * @return the new root
+ * */
+template <class T, template<typename ...> class N>
+template <template<typename ...> class M>
+auto BSTree<T, N>::relink(M<T> *node, std::size_t size) -> Node* {
+    BSTree<T, M>::toVine(node);
+    Node *root = build(node, size);
+    restore(root, nullptr);
+    return root;
+}
+
+/**
+ * Build a perfectly balanced sub-tree of size nodes from the first size nodes
+ * of a vine (the vine advances past them): nodes of this layout are relinked,
+ * those of another get their key moved to a new node and are freed right away.
+ * Parent links and heights are left to restore()
+ * */
+template <class T, template<typename ...> class N>
+template <class Source>
+auto BSTree<T, N>::build(Source *&vine, std::size_t size) -> Node* {
+    if (size == 0) return nullptr;
+    Node *left = build(vine, size / 2);
+    Source *source = vine;
+    vine = vine->right;
+    Node *node;
+    if constexpr (std::is_same<Source, Node>::value) {
+        node = source;
+    } else {
+        node = new Node(std::move(source->key));
+        delete source;
+    }
+    node->left = left;
+    node->right = build(vine, size - size / 2 - 1);
+    return node;
+}
+
+/**
+ * Link child (if any) to its parent, in node layouts with parent links
+ * */
+template <class T, template<typename ...> class N>
+inline void BSTree<T, N>::setParent(Node *child, Node *parent) {
+    if constexpr (PARENT_LINKS) {
+        if (child != nullptr) child->parent = parent;
+    }
+}
+
+/**
+ * Link both children of node to it, @see setParent()
+ * */
+template <class T, template<typename ...> class N>
+inline void BSTree<T, N>::adopt(Node *node) {
+    setParent(node->left, node);
+    setParent(node->right, node);
+}
+
+/**
+ * Parent of node, nullptr for root or in node layouts without parent links
+ * */
+template <class T, template<typename ...> class N>
+inline auto BSTree<T, N>::parentOf(const Node *node) -> Node* {
+    if constexpr (PARENT_LINKS) {
+        return node->parent;
+    } else {
+        return nullptr;
+    }
+}
+
+/**
+ * Next node in order, climbing the parent links when there is no right sub-tree
+ * @return the node, or nullptr after the greater element
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::successor(Node *node) -> Node* {
+    if (node->right != nullptr) {
+        for (node = node->right; node->left != nullptr; node = node->left) {}
+        return node;
+    }
+    Node *up = parentOf(node);
+    while (up != nullptr && up->right == node) {
+        node = up;
+        up = parentOf(node);
+    }
+    return up;
+}
+
+/**
+ * Previous node in order, @see successor()
+ * @return the node, or nullptr before the lesser element
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::predecessor(Node *node) -> Node* {
+    if (node->left != nullptr) {
+        for (node = node->left; node->right != nullptr; node = node->right) {}
+        return node;
+    }
+    Node *up = parentOf(node);
+    while (up != nullptr && up->left == node) {
+        node = up;
+        up = parentOf(node);
+    }
+    return up;
+}
+
+/**
+ * Restore the tree proprieties along path, bottom-up, after a node was attached
+ * at its end or removed below it. The nodes from path[dirty] down have changed
+ * sub-trees and must be visited; above them a derived tree may stop at the first
+ * node whose sub-tree height is unchanged. Nothing to do for a plain BST.
+ * @return the length of the path prefix still valid (unchanged by rotations)
+ * */
+template <class T, template<typename ...> class N>
+std::size_t BSTree<T, N>::retrace(Path &path, std::size_t dirty) {
+    (void) dirty;
+    return path.size();
+}
+
+/**
+ * Link a free node under the end of a path left by seek() (or as root),
+ * push it on the path and retrace
+ * @return the length of the path prefix still valid, @see retrace()
+ * */
+template <class T, template<typename ...> class N>
+std::size_t BSTree<T, N>::append(Path &path, Node *node) {
+    if (path.empty()) {
+        root = node;
+    } else if (node->key < path.back()->key) {
+        path.back()->left = node;
+    } else {
+        path.back()->right = node;
+    }
+    setParent(node, path.empty() ? nullptr : path.back());
+    path.push_back(node);
+    return retrace(path, path.size() - 1);
 }
 
 /**
@@ -253,38 +1278,131 @@ std::unique_ptr<T> BSTree<T, N>::remove(T key) {
  * */
 template <class T, template<typename ...> class N>
 std::unique_ptr<T> BSTree<T, N>::remove(T key, eRemove mode) {
+    std::unique_ptr<T> keyptr;
     switch (mode) {
         case COPY:
-            return removeByCopy(root, key);
+            keyptr = removeByCopy(root, key);
             break;
         case FUSION:
-            return removeByFusion(root, key);
+            keyptr = removeByFusion(root, key);
             break;
-        default:
-            return nullptr;
     }
+    refreshExtremes();
+    return keyptr;
 }
 
 /**
- * Remove the lesser element from the tree by FUSION (-> better performance)
+ * Remove the greater element from the tree
  * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
  * */
 template <class T, template<typename ...> class N>
 std::unique_ptr<T> BSTree<T, N>::removeMax() {
-    if (root == nullptr) return nullptr;
-    Node *&max = findMax(root);
-    return removeByFusion(max, max->key);
+    return removeExtreme(true);
 }
 
 /**
- * Remove the lesser element from the tree by FUSION (-> better performance)
+ * Remove the lesser element from the tree
  * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
  * */
 template <class T, template<typename ...> class N>
 std::unique_ptr<T> BSTree<T, N>::removeMin() {
+    return removeExtreme(false);
+}
+
+/**
+ * @see removeMin() and removeMax()
+ * */
+template <class T, template<typename ...> class N>
+std::unique_ptr<T> BSTree<T, N>::removeExtreme(bool greatest) {
+    Node *extreme = detachExtreme(greatest);
+    if (extreme == nullptr) return nullptr;
+    auto keyptr = std::make_unique<T>(std::move(extreme->key));
+    delete extreme;
+    return keyptr;
+}
+
+/**
+ * Unlink the lesser or greater node with a single walk down the spine:
+ * it has at most one child, which takes its place. The new extreme is that
+ * child's own extreme or the parent, so the cache is kept without another
+ * walk. Derived trees rebalance the spine in retrace().
+ * @return the unlinked node (not freed), or nullptr if the tree is empty
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::detachExtreme(bool greatest) -> Node* {
     if (root == nullptr) return nullptr;
-    Node *&min = findMin(root);
-    return removeByFusion(min, min->key);
+    Path path;
+    for (Node *node = root; node != nullptr; node = greatest ? node->right : node->left)
+        path.push_back(node);
+    Node *extreme = path.back();
+    Node *child = greatest ? extreme->left : extreme->right;
+    link(path, path.size() - 1) = child;
+    path.pop_back();
+    Node *next = path.empty() ? nullptr : path.back();
+    setParent(child, next);
+    if (child != nullptr) next = greatest ? findMax(child) : findMin(child);
+    (greatest ? maxNode : minNode) = next;
+    --nodeCount;
+    if ((greatest ? minNode : maxNode) == extreme)  // it was the only node
+        minNode = maxNode = nullptr;
+    extreme->left = extreme->right = nullptr;
+    retrace(path, path.size());
+    return extreme;
+}
+
+/**
+ * Link a free node (no children) in the tree, as insert(T key) without allocation
+ * @return false if its key already exists (the node is left untouched)
+ * */
+template <class T, template<typename ...> class N>
+bool BSTree<T, N>::attach(Node *node) {
+    Path path;
+    if (seek(path, node->key)) return false;
+    track(node);
+    append(path, node);
+    return true;
+}
+
+/**
+ * Unlink the node holding key from the tree, without freeing it. Nodes are
+ * relinked, never their keys moved: with two children its predecessor node
+ * takes its place, so the remaining nodes keep holding the same elements.
+ * @return the unlinked node (with no children), or nullptr if key does not exist
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::detach(const T &key) -> Node* {
+    Path path;
+    if (!seek(path, key)) return nullptr;
+    const std::size_t at = path.size() - 1;
+    Node *node = path.back();
+    Node *&place = link(path, at);
+    Node *up = at > 0 ? path[at - 1] : nullptr;
+    std::size_t dirty;
+    if (node->left == nullptr || node->right == nullptr) {
+        place = node->left ? node->left : node->right;
+        setParent(place, up);
+        path.pop_back();
+        dirty = path.size();
+    } else {
+        for (Node *max = node->left; max != nullptr; max = max->right)
+            path.push_back(max);
+        Node *max = path.back();
+        link(path, path.size() - 1) = max->left;
+        setParent(max->left, path[path.size() - 2]);
+        path.pop_back();
+        max->left = node->left;
+        max->right = node->right;
+        place = max;
+        setParent(max, up);
+        adopt(max);
+        path[at] = max;
+        dirty = at;  // max still holds the proprieties of its old position
+    }
+    node->left = node->right = nullptr;
+    untrack(node);
+    retrace(path, dirty);
+    refreshExtremes();
+    return node;
 }
 
 /**
@@ -305,6 +1423,59 @@ auto BSTree<T, N>::findMin(Node *&root) -> Node*& {
     return root->left ? findMin(root->left) : root;
 }
 
+/**
+ * Allocate a node for a new element, updating the cached extremes
+ * */
+template <class T, template<typename ...> class N>
+auto BSTree<T, N>::newNode(T &key) -> Node* {
+    Node *node = new Node(key);
+    track(node);
+    return node;
+}
+
+/**
+ * Free a node unlinked from the tree
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::deleteNode(Node *node) {
+    untrack(node);
+    delete node;
+}
+
+/**
+ * Count a node just linked in the tree, and take it as cached extreme if it is one
+ * */
+template <class T, template<typename ...> class N>
+inline void BSTree<T, N>::track(Node *node) {
+    ++nodeCount;
+    if (minNode == nullptr || node->key < minNode->key) minNode = node;
+    if (maxNode == nullptr || maxNode->key < node->key) maxNode = node;
+}
+
+/**
+ * Uncount a node unlinked from the tree, and forget it if it was a cached extreme
+ * (the removal then calls refreshExtremes() when the tree is consistent again)
+ * */
+template <class T, template<typename ...> class N>
+inline void BSTree<T, N>::untrack(Node *node) {
+    --nodeCount;
+    if (node == minNode) minNode = nullptr;
+    if (node == maxNode) maxNode = nullptr;
+}
+
+/**
+ * Look up the cached extremes forgotten by deleteNode()
+ * */
+template <class T, template<typename ...> class N>
+void BSTree<T, N>::refreshExtremes() {
+    if (root == nullptr) {
+        minNode = maxNode = nullptr;
+        return;
+    }
+    if (minNode == nullptr) minNode = findMin(root);
+    if (maxNode == nullptr) maxNode = findMax(root);
+}
+
 /**
  * Perform a removal by COPY
  * @see remove(T key, eRemove mode)
@@ -312,18 +1483,21 @@ auto BSTree<T, N>::findMin(Node *&root) -> Node*& {
 template <class T, template<typename ...> class N>
 std::unique_ptr<T> BSTree<T, N>::removeByCopy(Node *&node, T &key) {
     if (node == nullptr) return nullptr;
+    prefetch(node);
     if (node->key > key) return removeByCopy(node->left, key);
     if (node->key < key) return removeByCopy(node->right, key);
     auto keyptr = std::make_unique<T>(std::move(node->key));
     if (node->left != nullptr) {
         Node *&max = findMax(node->left);
-        node->key = max->key;
+        node->setKey(std::move(max->key));
         Node *temp = max->left;
-        delete max;
+        setParent(temp, parentOf(max));
+        deleteNode(max);
         max = temp;
     } else {
         Node *temp = node->right;
-        delete node;
+        setParent(temp, parentOf(node));
+        deleteNode(node);
         node = temp;
     }
     return keyptr;
@@ -336,19 +1510,86 @@ std::unique_ptr<T> BSTree<T, N>::removeByCopy(Node *&node, T &key) {
 template <class T, template<typename ...> class N>
 std::unique_ptr<T> BSTree<T, N>::removeByFusion(Node *&node, T &key) {
     if (node == nullptr) return nullptr;
+    prefetch(node);
     if (node->key > key) return removeByFusion(node->left, key);
     if (node->key < key) return removeByFusion(node->right, key);
     auto keyptr = std::make_unique<T>(std::move(node->key));
     Node *temp = node->right;
     if (node->left != nullptr) {
         temp = node->left;
-        findMax(node->left) ->right = node->right;
+        Node *max = findMax(node->left);
+        max->right = node->right;
+        setParent(max->right, max);
     }
-    delete node;
+    setParent(temp, parentOf(node));
+    deleteNode(node);
     node = temp;
     return keyptr;
 }
 
+/**
+ * Call visitor on the elements in a given order until it answers STOP.
+ * The visitor takes a const T& (the element) or a const Node& (to read
+ * the node's own data, as AVLNode::height; generic lambdas get the node),
+ * and returns a eVisit.
+ * SKIP prunes what is left of the node's sub-trees: both in preorder and
+ * level-order, the right one in inorder, none in postorder.
+ * @return true if the visitor stopped the traversal
+ * @example: bst.visit(INORDER, [&](const T& key) { return key > x ? STOP : CONTINUE; });
+ * */
+template <class T, template<typename ...> class N>
+template <class Visitor>
+bool BSTree<T, N>::visit(eOrder order, Visitor&& visitor) const {
+    if (order != LEVELORDER) return visit(root, order, visitor) == STOP;
+    std::vector<const Node*> level, next;
+    if (root != nullptr) level.push_back(root);
+    while (!level.empty()) {
+        for (const Node *node : level) {
+            eVisit answer = call(visitor, *node);
+            if (answer == STOP) return true;
+            if (answer == SKIP) continue;
+            if (node->left != nullptr) next.push_back(node->left);
+            if (node->right != nullptr) next.push_back(node->right);
+        }
+        level.swap(next);
+        next.clear();
+    }
+    return false;
+}
+
+/**
+ * @see visit(eOrder order, Visitor&& visitor)
+ * @return STOP if the visitor stopped the traversal, CONTINUE otherwise
+ * */
+template <class T, template<typename ...> class N>
+template <class Visitor>
+eVisit BSTree<T, N>::visit(const Node *node, eOrder order, Visitor &visitor) const {
+    if (node == nullptr) return CONTINUE;
+    eVisit answer;
+    if (order == PREORDER && (answer = call(visitor, *node)) != CONTINUE)
+        return answer == STOP ? STOP : CONTINUE;
+    if (visit(node->left, order, visitor) == STOP) return STOP;
+    if (order == INORDER && (answer = call(visitor, *node)) != CONTINUE)
+        return answer == STOP ? STOP : CONTINUE;
+    if (visit(node->right, order, visitor) == STOP) return STOP;
+    if (order == POSTORDER && call(visitor, *node) == STOP) return STOP;
+    return CONTINUE;
+}
+
+/**
+ * Pass a node, or its element, to a visitor
+ * @see visit(eOrder order, Visitor&& visitor)
+ * */
+template <class T, template<typename ...> class N>
+template <class Visitor>
+inline eVisit BSTree<T, N>::call(Visitor &visitor, const Node &node) {
+    if constexpr (std::is_invocable_v<Visitor&, const Node&>) {
+        return visitor(node);
+    } else {
+        return visitor(node.key);
+    }
+}
+
 /**
  * Print to console in a given order
  * */
@@ -364,6 +1605,9 @@ std::ostream& BSTree<T, N>::print(std::ostream& os, eOrder order) const {
         case POSTORDER:
             postorder(os, root);
             break;
+        case LEVELORDER:
+            for (const T& key : traverse(LEVELORDER)) os << key << " ";
+            break;
     }
     return os;
 }
@@ -395,6 +1639,33 @@ void BSTree<T, N>::postorder(std::ostream& os, const Node *node) const {
     os << *node << " ";
 }
 
+/**
+ * Request the nodes the descent may visit after this one, according to the
+ * prefetching mode, so their loads overlap with the comparison at this node
+ * @see setPrefetch(ePrefetch mode)
+ * */
+template <class T, template<typename ...> class N>
+inline void BSTree<T, N>::prefetch(const Node *node) const {
+    switch (prefetching) {
+        case NO_PREFETCH:
+            break;
+        case PREFETCH_CHILDREN:
+            base::prefetch(node->left);
+            base::prefetch(node->right);
+            break;
+        case PREFETCH_GRANDCHILDREN:
+            if (node->left != nullptr) {
+                base::prefetch(node->left->left);
+                base::prefetch(node->left->right);
+            }
+            if (node->right != nullptr) {
+                base::prefetch(node->right->left);
+                base::prefetch(node->right->right);
+            }
+            break;
+    }
+}
+
 /**
  * Overloading for insertion like: bst << key;
  * */
@@ -432,6 +1703,7 @@ inline std::ostream& operator<<(std::ostream& os, const BSTree<T>& bst) {
  * std::cout << inorder(bst);
  * std::cout << preorder(bst);
  * std::cout << postorder(bst);
+ * std::cout << levelorder(bst);
  * */
 namespace trees {
 
@@ -450,6 +1722,11 @@ inline std::pair<BSTree<T>&, eOrder> postorder(BSTree<T>& bst) {
     return std::make_pair(std::ref(bst), POSTORDER);
 }
 
+template <class T>
+inline std::pair<BSTree<T>&, eOrder> levelorder(BSTree<T>& bst) {
+    return std::make_pair(std::ref(bst), LEVELORDER);
+}
+
 template <class T>
 inline std::ostream& operator<<(std::ostream& os, std::pair<BSTree<T>&, eOrder> p) {
     return p.first.print(os, p.second);
@@ -0,0 +1,867 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+
+/**
+ * @file: BucketAVLTree.hpp
+ *
+ * Define a AVL Tree whose nodes hold up to K elements each, sorted, instead
+ * of one: every element of a node's left sub-tree is less than its first and
+ * every element of its right sub-tree greater than its last. The links and
+ * height are paid once per node (about K times less per element than an
+ * AVLNode, which also has a vptr) and scans read K neighbours per node.
+ * A full node receiving an element passes its greatest on to the least place
+ * of its right sub-tree (a new node only where no node has room); a node
+ * left under half full by a removal takes elements from a neighbour node in
+ * order, or merges with it when both fit in one.
+ * Balanced with the height and rotations of the AVLTree.
+ * @see description in AVLTree.hpp
+ *
+ * @example:
+ * BucketAVLTree<T> avl;  // 16 elements per node, BucketAVLTree<T, 32> for 32
+ * avl.insert(t1)  // ou avl << t2;
+ * avl.remove(t1)
+ * T *t = avl.get(t2);
+ * for (const T& t : avl) ...
+ * avl.print(cout, INORDER);  // ou cout << avl;
+ *
+ * */
+
+#ifndef _BUCKETAVLTREE_HPP_
+#define _BUCKETAVLTREE_HPP_
+
+#include <memory>
+#include <utility>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <type_traits>
+#include "BSTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+/** Node of BucketAVLTree: a sorted array of up to K elements */
+template <class T, std::size_t K>
+struct BucketAVLNode {
+    BucketAVLNode *left = nullptr;
+    BucketAVLNode *right = nullptr;
+    std::uint16_t count = 1;  // elements in use, from keys[0]
+    std::uint8_t height = 1;
+    T keys[K] = {};
+
+    explicit BucketAVLNode(T &key) { keys[0] = std::move(key); }
+    const T& first() const { return keys[0]; }
+    const T& last() const { return keys[count - 1]; }
+    bool isFull() const { return count == K; }
+    std::size_t lowerBound(const T &key) const;
+    void insertAt(std::size_t at, T &key);
+    T eraseAt(std::size_t at);
+    void prepend(BucketAVLNode &prev, std::size_t n);
+    void append(BucketAVLNode &next, std::size_t n);
+    void updateHeight();
+};
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * AVL Tree with K elements per node
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T, std::size_t K = 16>
+class BucketAVLTree {
+    static_assert(K >= 2 && K <= 0xFFFF, "a node holds 2 to 65535 elements");
+
+ public:
+    using Node = BucketAVLNode<T, K>;  // aliases for the node type
+    using Path = base::Stack<Node*, 64>;  // nodes from root down to a position
+    static constexpr std::size_t MIN_FILL = K / 2;  // a removal refills or merges a node below it
+
+    /**
+     * In-order iterator over the keys, holding the path from root to its
+     * node and the index in it. Any change to the tree invalidates it.
+     * */
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        reference operator*() const { return path.back()->keys[at]; }
+        pointer operator->() const { return &path.back()->keys[at]; }
+        iterator& operator++();
+        iterator operator++(int) { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator& other) const {
+            return node() == other.node() && at == other.at;
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+     private:
+        friend class BucketAVLTree;
+        Node* node() const { return path.empty() ? nullptr : path.back(); }
+        void descend(Node *node);
+        Path path;  // empty for end()
+        std::size_t at = 0;
+    };
+
+    BucketAVLTree() {}
+    BucketAVLTree(const BucketAVLTree&) = delete;  // no deep copy (yet), the nodes would be shared
+    BucketAVLTree(BucketAVLTree &&other) noexcept { take(other); }
+    ~BucketAVLTree() { destroy(root); }
+    BucketAVLTree& operator=(const BucketAVLTree&) = delete;
+    BucketAVLTree& operator=(BucketAVLTree &&other) noexcept;
+
+    /* External Methods */
+    operator bool() const { return root != nullptr; }
+    bool isEmpty() const { return root == nullptr; }
+    std::size_t size() const { return elements; }
+    std::size_t nodes() const { return nodeCount; }
+    void clear();
+    T* get(T key) const;
+    T* getMax() const;
+    T* getMin() const;
+    bool insert(T key);
+    std::unique_ptr<T> remove(T key);
+    std::unique_ptr<T> removeMax();
+    std::unique_ptr<T> removeMin();
+    iterator begin() const;
+    iterator end() const { return iterator(); }
+    std::ostream& print(std::ostream& os, eOrder order = INORDER) const;
+
+    template <class _T, std::size_t _K>
+    friend BucketAVLTree<_T, _K>& operator<<(BucketAVLTree<_T, _K>& avl, _T key);
+    template <class _T, std::size_t _K>
+    friend std::ostream& operator<<(std::ostream& os, const BucketAVLTree<_T, _K>& avl);
+
+ protected:
+    Node *root = nullptr;
+    std::size_t elements = 0;
+    std::size_t nodeCount = 0;
+
+    /* Internal recursive Methods */
+    void destroy(Node *node);
+    void take(BucketAVLTree &other);
+    Node* newNode(T &key);
+    void deleteNode(Node *node);
+    bool insert(Node *&node, T &key, bool &grew);
+    bool insertMin(Node *&node, T &key);
+    std::unique_ptr<T> remove(Node *&node, T &key);
+    void refill(Node *&node);
+    void refillChild(Node *node, bool right, int before);
+    void mergeMax(Node *&node, Node *into);
+    void mergeMin(Node *&node, Node *into);
+    T takeMax(Node *&node);
+    T takeMin(Node *&node);
+    void balance(Node *&node);
+    bool rebalance(Node *&node);
+    static int height(const Node *node) { return node ? node->height : 0; }
+    static int bFactor(const Node *node) { return height(node->left) - height(node->right); }
+    static void rotateLeft(Node *&node);
+    static void rotateRight(Node *&node);
+    void print(std::ostream& os, const Node *node) const;
+    void inorder(std::ostream& os, const Node *node) const;
+    void preorder(std::ostream& os, const Node *node) const;
+    void postorder(std::ostream& os, const Node *node) const;
+    void levelorder(std::ostream& os, const Node *node) const;
+};
+
+
+
+
+
+/**
+ * >> BucketAVLNode implementation <<
+ * */
+
+/**
+ * Index of the first element not less than key (count if none). Arithmetic
+ * keys are counted without branches over all K places (unused ones hold a
+ * value too), a loop of fixed length the compiler vectorizes; others by
+ * binary search.
+ * */
+template <class T, std::size_t K>
+std::size_t BucketAVLNode<T, K>::lowerBound(const T &key) const {
+    if constexpr (std::is_arithmetic<T>::value) {
+        const unsigned used = count;
+        unsigned at = 0;
+        for (unsigned i = 0; i < K; ++i) at += (keys[i] < key) & (i < used);
+        return at;
+    } else {
+        std::size_t lo = 0, hi = count;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (keys[mid] < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+}
+
+/**
+ * Place key at an index, shifting the greater elements one place up (not full)
+ * */
+template <class T, std::size_t K>
+void BucketAVLNode<T, K>::insertAt(std::size_t at, T &key) {
+    for (std::size_t i = count; i > at; --i) keys[i] = std::move(keys[i - 1]);
+    keys[at] = std::move(key);
+    ++count;
+}
+
+/**
+ * Move out the element at an index, shifting the greater elements one place down
+ * */
+template <class T, std::size_t K>
+T BucketAVLNode<T, K>::eraseAt(std::size_t at) {
+    T key = std::move(keys[at]);
+    for (std::size_t i = at + 1; i < count; ++i) keys[i - 1] = std::move(keys[i]);
+    --count;
+    return key;
+}
+
+/**
+ * Move the n greater elements of prev (its neighbour before it, in order) to
+ * the front of this node (count + n <= K)
+ * */
+template <class T, std::size_t K>
+void BucketAVLNode<T, K>::prepend(BucketAVLNode &prev, std::size_t n) {
+    for (std::size_t i = count; i-- > 0; ) keys[i + n] = std::move(keys[i]);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = std::move(prev.keys[prev.count - n + i]);
+    count = static_cast<std::uint16_t>(count + n);
+    prev.count = static_cast<std::uint16_t>(prev.count - n);
+}
+
+/**
+ * Move the n lesser elements of next (its neighbour after it, in order) to
+ * the end of this node (count + n <= K)
+ * */
+template <class T, std::size_t K>
+void BucketAVLNode<T, K>::append(BucketAVLNode &next, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) keys[count + i] = std::move(next.keys[i]);
+    for (std::size_t i = n; i < next.count; ++i) next.keys[i - n] = std::move(next.keys[i]);
+    count = static_cast<std::uint16_t>(count + n);
+    next.count = static_cast<std::uint16_t>(next.count - n);
+}
+
+/**
+ * Recompute the height from the children's
+ * */
+template <class T, std::size_t K>
+void BucketAVLNode<T, K>::updateHeight() {
+    int leftH = left ? left->height : 0;
+    int rightH = right ? right->height : 0;
+    height = static_cast<std::uint8_t>((leftH > rightH ? leftH : rightH) + 1);
+}
+
+
+
+/**
+ * >> BucketAVLTree implementation <<
+ * */
+
+/**
+ * Replace the elements by another tree's, in O(1), leaving it empty
+ * */
+template <class T, std::size_t K>
+BucketAVLTree<T, K>& BucketAVLTree<T, K>::operator=(BucketAVLTree &&other) noexcept {
+    if (this != &other) {
+        clear();
+        take(other);
+    }
+    return *this;
+}
+
+/**
+ * Take the nodes of another (this one is empty)
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::take(BucketAVLTree &other) {
+    std::swap(root, other.root);
+    std::swap(elements, other.elements);
+    std::swap(nodeCount, other.nodeCount);
+}
+
+/**
+ * Clear the tree, deleting all nodes
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::clear() {
+    destroy(root);
+    root = nullptr;
+    elements = nodeCount = 0;
+}
+
+/**
+ * Delete a node and its sub-trees
+ * @see clear()
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::destroy(Node *node) {
+    if (node != nullptr) {
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+}
+
+/**
+ * Allocate a node holding key alone
+ * */
+template <class T, std::size_t K>
+auto BucketAVLTree<T, K>::newNode(T &key) -> Node* {
+    ++nodeCount;
+    return new Node(key);
+}
+
+/**
+ * Delete an emptied node
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::deleteNode(Node *node) {
+    --nodeCount;
+    delete node;
+}
+
+/**
+ * Search for a element, from root: the node whose range holds the key,
+ * then the key in it
+ * @return a pointer to the element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t K>
+T* BucketAVLTree<T, K>::get(T key) const {
+    for (Node *node = root; node != nullptr; ) {
+        if (key < node->first()) {
+            node = node->left;
+        } else if (node->last() < key) {
+            node = node->right;
+        } else {
+            std::size_t at = node->lowerBound(key);
+            return key < node->keys[at] ? nullptr : &node->keys[at];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * The greater element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t K>
+T* BucketAVLTree<T, K>::getMax() const {
+    Node *node = root;
+    if (node == nullptr) return nullptr;
+    while (node->right != nullptr) node = node->right;
+    return &node->keys[node->count - 1];
+}
+
+/**
+ * The lesser element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t K>
+T* BucketAVLTree<T, K>::getMin() const {
+    Node *node = root;
+    if (node == nullptr) return nullptr;
+    while (node->left != nullptr) node = node->left;
+    return &node->keys[0];
+}
+
+/**
+ * Insert a element in the tree
+ * @return true if element was inserted succefully, or false if it already exists
+ * */
+template <class T, std::size_t K>
+bool BucketAVLTree<T, K>::insert(T key) {
+    bool grew;
+    return insert(root, key, grew);
+}
+
+/**
+ * Insert a element in a sub-tree: in the node whose range holds it, or in the
+ * last node of the path when none does. A full node passes its greatest
+ * element on to its right sub-tree, @see insertMin(). Only while the sub-trees
+ * grow are the nodes above balanced; a key placed in a node's array changes none.
+ * @param grew set to whether the sub-tree height changed
+ * */
+template <class T, std::size_t K>
+bool BucketAVLTree<T, K>::insert(Node *&node, T &key, bool &grew) {
+    grew = false;
+    if (node == nullptr) {
+        node = newNode(key);
+        ++elements;
+        grew = true;
+        return true;
+    }
+    if (key < node->first() && node->left != nullptr) {
+        if (!insert(node->left, key, grew)) return false;
+    } else if (node->last() < key && node->right != nullptr) {
+        if (!insert(node->right, key, grew)) return false;
+    } else {
+        std::size_t at = node->lowerBound(key);
+        if (at < node->count && !(key < node->keys[at])) return false;
+        ++elements;
+        if (!node->isFull()) {
+            node->insertAt(at, key);
+            return true;  // same nodes, same heights
+        }
+        if (at == 0) {  // less than all, no left sub-tree
+            node->left = newNode(key);
+            grew = true;
+        } else if (at == K) {  // greater than all, no right sub-tree
+            node->right = newNode(key);
+            grew = true;
+        } else {
+            T greatest = node->eraseAt(K - 1);
+            node->insertAt(at, key);
+            grew = insertMin(node->right, greatest);
+        }
+    }
+    if (grew) grew = rebalance(node);
+    return true;
+}
+
+/**
+ * Insert a element less than every element of a sub-tree: at the front of
+ * its least node, or in a new node left of it when that one is full
+ * @return whether the sub-tree height changed
+ * */
+template <class T, std::size_t K>
+bool BucketAVLTree<T, K>::insertMin(Node *&node, T &key) {
+    if (node == nullptr) {
+        node = newNode(key);
+        return true;
+    }
+    if (node->left != nullptr) {
+        if (!insertMin(node->left, key)) return false;
+    } else if (!node->isFull()) {
+        node->insertAt(0, key);
+        return false;
+    } else {
+        node->left = newNode(key);
+    }
+    return rebalance(node);
+}
+
+/**
+ * Remove a element from the tree
+ * @return a pointer to the removed element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t K>
+std::unique_ptr<T> BucketAVLTree<T, K>::remove(T key) {
+    return remove(root, key);
+}
+
+/**
+ * Remove a element from a sub-tree. The node it leaves under MIN_FILL is
+ * refilled from its neighbours in its sub-trees, else from its parent.
+ * @see refill(), refillChild()
+ * */
+template <class T, std::size_t K>
+std::unique_ptr<T> BucketAVLTree<T, K>::remove(Node *&node, T &key) {
+    if (node == nullptr) return nullptr;
+    std::unique_ptr<T> keyptr;
+    if (key < node->first()) {
+        int before = height(node->left);
+        keyptr = remove(node->left, key);
+        if (keyptr) refillChild(node, false, before);
+    } else if (node->last() < key) {
+        int before = height(node->right);
+        keyptr = remove(node->right, key);
+        if (keyptr) refillChild(node, true, before);
+    } else {
+        std::size_t at = node->lowerBound(key);
+        if (key < node->keys[at]) return nullptr;
+        keyptr = std::make_unique<T>(node->eraseAt(at));
+        --elements;
+        if (node->count >= MIN_FILL) return keyptr;  // same nodes, same heights
+        refill(node);
+        if (node == nullptr) return keyptr;
+    }
+    if (keyptr) balance(node);
+    return keyptr;
+}
+
+/**
+ * Bring a node back to MIN_FILL elements from its neighbours in order in its
+ * sub-trees: the greatest node of the left one, then the least of the right
+ * one. A neighbour that fits in the node with it is merged in and deleted,
+ * else it gives the elements missing and keeps MIN_FILL or more (it had over
+ * K - count). The node is deleted if it ends empty (no sub-trees). Each side
+ * deletes one node at most, so no sub-tree loses more than one level and
+ * balance() can fix the node.
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::refill(Node *&node) {
+    if (node->count < MIN_FILL && node->left != nullptr) {
+        Node *prev = node->left;
+        while (prev->right != nullptr) prev = prev->right;
+        if (prev->count + node->count <= K) {
+            mergeMax(node->left, node);
+        } else {
+            node->prepend(*prev, MIN_FILL - node->count);
+        }
+    }
+    if (node->count < MIN_FILL && node->right != nullptr) {
+        Node *next = node->right;
+        while (next->left != nullptr) next = next->left;
+        if (next->count + node->count <= K) {
+            mergeMin(node->right, node);
+        } else {
+            node->append(*next, MIN_FILL - node->count);
+        }
+    }
+    if (node->count == 0) {  // no sub-trees either
+        deleteNode(node);
+        node = nullptr;
+    }
+}
+
+/**
+ * Refill a child of node left under MIN_FILL with no sub-tree on node's side
+ * (a leaf, most often), whose neighbour in order is node itself: merged into
+ * node if both fit, else given the elements missing by node, which keeps
+ * MIN_FILL or more. The merge deletes the child, so it waits while the removal
+ * below already took a level from it: this side loses one level at most.
+ * @param before the height of the child's sub-tree before the removal
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::refillChild(Node *node, bool right, int before) {
+    Node *&child = right ? node->right : node->left;
+    if (child == nullptr || child->count >= MIN_FILL) return;
+    if ((right ? child->left : child->right) != nullptr) return;  // its neighbour is below it
+    if (child->count + node->count > K) {
+        if (right) {
+            child->prepend(*node, MIN_FILL - child->count);
+        } else {
+            child->append(*node, MIN_FILL - child->count);
+        }
+    } else if (child->height == before) {
+        Node *rest = right ? child->right : child->left;
+        if (right) {
+            node->append(*child, child->count);
+        } else {
+            node->prepend(*child, child->count);
+        }
+        deleteNode(child);
+        child = rest;
+    }
+}
+
+/**
+ * Move all elements of the greatest node of a sub-tree to the front of into,
+ * deleting that node
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::mergeMax(Node *&node, Node *into) {
+    if (node->right != nullptr) {
+        mergeMax(node->right, into);
+        balance(node);
+        return;
+    }
+    into->prepend(*node, node->count);
+    Node *left = node->left;
+    deleteNode(node);
+    node = left;
+}
+
+/**
+ * Move all elements of the least node of a sub-tree to the end of into,
+ * deleting that node
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::mergeMin(Node *&node, Node *into) {
+    if (node->left != nullptr) {
+        mergeMin(node->left, into);
+        balance(node);
+        return;
+    }
+    into->append(*node, node->count);
+    Node *right = node->right;
+    deleteNode(node);
+    node = right;
+}
+
+/**
+ * Move out the greater element of a sub-tree. Its node is refilled when left
+ * under MIN_FILL, as by remove(), and deleted if emptied.
+ * */
+template <class T, std::size_t K>
+T BucketAVLTree<T, K>::takeMax(Node *&node) {
+    if (node->right != nullptr) {
+        int before = node->right->height;
+        T key = takeMax(node->right);
+        refillChild(node, true, before);
+        balance(node);
+        return key;
+    }
+    T key = node->eraseAt(node->count - 1);
+    if (node->count < MIN_FILL) {
+        refill(node);
+        if (node != nullptr) balance(node);
+    }
+    return key;
+}
+
+/**
+ * Move out the lesser element of a sub-tree. Its node is refilled when left
+ * under MIN_FILL, as by remove(), and deleted if emptied.
+ * */
+template <class T, std::size_t K>
+T BucketAVLTree<T, K>::takeMin(Node *&node) {
+    if (node->left != nullptr) {
+        int before = node->left->height;
+        T key = takeMin(node->left);
+        refillChild(node, false, before);
+        balance(node);
+        return key;
+    }
+    T key = node->eraseAt(0);
+    if (node->count < MIN_FILL) {
+        refill(node);
+        if (node != nullptr) balance(node);
+    }
+    return key;
+}
+
+/**
+ * Remove the greater element in the tree
+ * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t K>
+std::unique_ptr<T> BucketAVLTree<T, K>::removeMax() {
+    if (root == nullptr) return nullptr;
+    --elements;
+    return std::make_unique<T>(takeMax(root));
+}
+
+/**
+ * Remove the lesser element in the tree
+ * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t K>
+std::unique_ptr<T> BucketAVLTree<T, K>::removeMin() {
+    if (root == nullptr) return nullptr;
+    --elements;
+    return std::make_unique<T>(takeMin(root));
+}
+
+/**
+ * Balance the node, as AVLTree::balance()
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::balance(Node *&node) {
+    node->updateHeight();
+    int bf = bFactor(node);
+    if (bf == 2) {
+        if (bFactor(node->left) < 0)
+            rotateLeft(node->left);
+        rotateRight(node);
+    } else if (bf == -2) {
+        if (bFactor(node->right) > 0)
+            rotateRight(node->right);
+        rotateLeft(node);
+    }
+}
+
+/**
+ * Balance the node after one of its sub-trees changed height
+ * @return whether the height of the sub-tree (rooted at node, rotated or not) changed
+ * */
+template <class T, std::size_t K>
+bool BucketAVLTree<T, K>::rebalance(Node *&node) {
+    int before = node->height;
+    balance(node);
+    return node->height != before;
+}
+
+/**
+ * Rotate the sub-tree to the left, as AVLTree::rotateLeft()
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::rotateLeft(Node *&node) {
+    Node *temp = node->right->left;
+    node->right->left = node;
+    node = node->right;
+    node->left->right = temp;
+    node->left->updateHeight();
+    node->updateHeight();
+}
+
+/**
+ * Rotate the sub-tree to the right, as AVLTree::rotateRight()
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::rotateRight(Node *&node) {
+    Node *temp = node->left->right;
+    node->left->right = node;
+    node = node->left;
+    node->right->left = temp;
+    node->right->updateHeight();
+    node->updateHeight();
+}
+
+/**
+ * Position of the lesser element, end() if the tree is empty
+ * */
+template <class T, std::size_t K>
+auto BucketAVLTree<T, K>::begin() const -> iterator {
+    iterator it;
+    it.descend(root);
+    return it;
+}
+
+/**
+ * Walk down the left children, from node
+ * */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::iterator::descend(Node *node) {
+    for (; node != nullptr; node = node->left) path.push_back(node);
+    at = 0;
+}
+
+/**
+ * Next element in order: in the same node, else the first of the next node
+ * */
+template <class T, std::size_t K>
+auto BucketAVLTree<T, K>::iterator::operator++() -> iterator& {
+    if (++at < path.back()->count) return *this;
+    Node *right = path.back()->right;
+    if (right != nullptr) {
+        descend(right);
+    } else {  // climb while coming from a right child
+        Node *child = path.back();
+        path.pop_back();
+        while (!path.empty() && path.back()->right == child) {
+            child = path.back();
+            path.pop_back();
+        }
+        at = 0;
+    }
+    return *this;
+}
+
+/**
+ * Print to console in a given order, the order of the nodes: the elements
+ * of a node print together, in order
+ * */
+template <class T, std::size_t K>
+std::ostream& BucketAVLTree<T, K>::print(std::ostream& os, eOrder order) const {
+    switch (order) {
+        case INORDER:
+            inorder(os, root);
+            break;
+        case PREORDER:
+            preorder(os, root);
+            break;
+        case POSTORDER:
+            postorder(os, root);
+            break;
+        case LEVELORDER:
+            levelorder(os, root);
+            break;
+    }
+    return os;
+}
+
+/** The elements of a node, @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::print(std::ostream& os, const Node *node) const {
+    for (std::size_t i = 0; i < node->count; ++i) os << node->keys[i] << " ";
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::inorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    inorder(os, node->left);
+    print(os, node);
+    inorder(os, node->right);
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::preorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    print(os, node);
+    preorder(os, node->left);
+    preorder(os, node->right);
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::postorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    postorder(os, node->left);
+    postorder(os, node->right);
+    print(os, node);
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t K>
+void BucketAVLTree<T, K>::levelorder(std::ostream& os, const Node *node) const {
+    std::vector<const Node*> level, next;
+    if (node != nullptr) level.push_back(node);
+    while (!level.empty()) {
+        for (const Node *n : level) {
+            print(os, n);
+            if (n->left != nullptr) next.push_back(n->left);
+            if (n->right != nullptr) next.push_back(n->right);
+        }
+        level.swap(next);
+        next.clear();
+    }
+}
+
+/**
+ * Overloading for insertion like: avl << key;
+ * */
+template <class T, std::size_t K>
+inline BucketAVLTree<T, K>& operator<<(BucketAVLTree<T, K>& avl, T key) {
+    avl.insert(key);
+    return avl;
+}
+
+/**
+ * Overloading for printing like: std::cout << avl;
+ * */
+template <class T, std::size_t K>
+inline std::ostream& operator<<(std::ostream& os, const BucketAVLTree<T, K>& avl) {
+    avl.inorder(os, avl.root);
+    return os;
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _BUCKETAVLTREE_HPP_
@@ -0,0 +1,233 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+
+/**
+ * @file: ConstexprTree.hpp
+ *
+ * Define a read-only ordered set built at compile time from a list of keys:
+ * they are sorted, deduplicated and laid out as a perfectly balanced tree in
+ * an array, in breadth-first (Eytzinger) order, the children of the node at
+ * position k (from 1) being at 2k and 2k + 1. No links, no allocation and,
+ * declared constexpr, no startup cost: get, contains and lowerBound work in
+ * constant expressions as well as at run time. The descent has no branch to
+ * mispredict, its next position is computed from the comparison.
+ * Keys must be literal types (int, char, std::string_view, ...).
+ *
+ * @example:
+ * constexpr auto opcodes = makeConstexprTree({0x90, 0xC3, 0xE8, 0xCC});
+ * static_assert(opcodes.contains(0xC3));
+ * constexpr auto words = makeConstexprTree<std::string_view>({"if", "else", "for"});
+ * const std::string_view *w = words.get(token);
+ * const std::string_view *next = words.lowerBound("f");  // "for"
+ * for (std::string_view w : words) ...  // in order
+ *
+ * */
+
+#ifndef _CONSTEXPRTREE_HPP_
+#define _CONSTEXPRTREE_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * Ordered set built at compile time
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T, std::size_t N>
+class ConstexprTree {
+    static_assert(N > 0, "a tree of no keys");
+
+ public:
+    /** In-order iterator: a position in the array, moving to the in-order successor */
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        constexpr iterator() {}
+        constexpr reference operator*() const { return tree->nodes[at - 1]; }
+        constexpr pointer operator->() const { return &tree->nodes[at - 1]; }
+        constexpr iterator& operator++() { at = tree->next(at); return *this; }
+        constexpr iterator operator++(int) { iterator it = *this; ++*this; return it; }
+        constexpr bool operator==(const iterator& other) const { return at == other.at; }
+        constexpr bool operator!=(const iterator& other) const { return at != other.at; }
+
+     private:
+        friend class ConstexprTree;
+        constexpr iterator(const ConstexprTree *tree, std::size_t at) : tree(tree), at(at) {}
+        const ConstexprTree *tree = nullptr;
+        std::size_t at = 0;  // from 1, 0 for end()
+    };
+
+    constexpr explicit ConstexprTree(const T (&keys)[N]);
+
+    /* External Methods */
+    constexpr std::size_t size() const { return count; }
+    constexpr const T* get(const T &key) const;
+    constexpr bool contains(const T &key) const { return get(key) != nullptr; }
+    constexpr const T* lowerBound(const T &key) const;
+    constexpr const T* getMax() const { return &nodes[extreme(1) - 1]; }
+    constexpr const T* getMin() const { return &nodes[extreme(0) - 1]; }
+    constexpr iterator begin() const { return iterator(this, extreme(0)); }
+    constexpr iterator end() const { return iterator(); }
+    std::ostream& print(std::ostream& os) const;
+
+ protected:
+    T nodes[N] = {};  // node k at nodes[k - 1], the first 'count' in use
+    std::size_t count = 0;  // distinct keys
+
+    /* Internal Methods */
+    constexpr std::size_t lowerPosition(const T &key) const;
+    constexpr std::size_t extreme(int dir) const;
+    constexpr std::size_t next(std::size_t at) const;
+};
+
+
+
+
+
+/**
+ * >> ConstexprTree implementation <<
+ * */
+
+/**
+ * Sort the keys (insertion sort: fine for tables of compile-time size and
+ * a constant expression before C++20's std::sort), drop the repeated ones
+ * and place them visiting the positions in order
+ * */
+template <class T, std::size_t N>
+constexpr ConstexprTree<T, N>::ConstexprTree(const T (&keys)[N]) {
+    T sorted[N] = {};
+    for (std::size_t i = 0; i < N; ++i) {
+        std::size_t j = i;
+        for (; j > 0 && keys[i] < sorted[j - 1]; --j) sorted[j] = sorted[j - 1];
+        sorted[j] = keys[i];
+    }
+    for (std::size_t i = 0; i < N; ++i)
+        if (count == 0 || sorted[count - 1] < sorted[i]) sorted[count++] = sorted[i];
+    std::size_t at = extreme(0);
+    for (std::size_t i = 0; i < count; ++i, at = next(at)) nodes[at - 1] = sorted[i];
+}
+
+/**
+ * Search for a element, from root
+ * @return a pointer to the element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t N>
+constexpr const T* ConstexprTree<T, N>::get(const T &key) const {
+    std::size_t at = lowerPosition(key);
+    return at != 0 && !(key < nodes[at - 1]) ? &nodes[at - 1] : nullptr;
+}
+
+/**
+ * The least element not less than key
+ * @return a pointer to the element, or nullptr if every element is less
+ * */
+template <class T, std::size_t N>
+constexpr const T* ConstexprTree<T, N>::lowerBound(const T &key) const {
+    std::size_t at = lowerPosition(key);
+    return at != 0 ? &nodes[at - 1] : nullptr;
+}
+
+/**
+ * Position of the least element not less than key, 0 if none. The descent
+ * goes to 2k + (node k < key) down to past a leaf; the answer is the last
+ * node where it went left: drop the trailing right turns (1 bits) and one more.
+ * */
+template <class T, std::size_t N>
+constexpr std::size_t ConstexprTree<T, N>::lowerPosition(const T &key) const {
+    std::size_t at = 1;
+    while (at <= count) at = 2 * at + (nodes[at - 1] < key);
+    while (at & 1) at >>= 1;
+    return at >> 1;
+}
+
+/**
+ * Position of the last node down the left (dir 0) or right (dir 1) spine, 0 if empty
+ * */
+template <class T, std::size_t N>
+constexpr std::size_t ConstexprTree<T, N>::extreme(int dir) const {
+    if (count == 0) return 0;
+    std::size_t at = 1;
+    while (2 * at + dir <= count) at = 2 * at + dir;
+    return at;
+}
+
+/**
+ * Position of the in-order successor, 0 after the greater element:
+ * the least of the right sub-tree, or the first ancestor reached from a left child
+ * */
+template <class T, std::size_t N>
+constexpr std::size_t ConstexprTree<T, N>::next(std::size_t at) const {
+    if (2 * at + 1 <= count) {
+        at = 2 * at + 1;
+        while (2 * at <= count) at = 2 * at;
+        return at;
+    }
+    while (at & 1) at >>= 1;
+    return at >> 1;
+}
+
+/**
+ * Print to console, in order
+ * */
+template <class T, std::size_t N>
+std::ostream& ConstexprTree<T, N>::print(std::ostream& os) const {
+    for (const T& key : *this) os << key << " ";
+    return os;
+}
+
+/**
+ * Build a ConstexprTree from a list of keys, the key type deduced or given:
+ * constexpr auto set = makeConstexprTree({3, 1, 2});
+ * */
+template <class T, std::size_t N>
+constexpr ConstexprTree<T, N> makeConstexprTree(const T (&keys)[N]) {
+    return ConstexprTree<T, N>(keys);
+}
+
+/**
+ * Overloading for printing like: std::cout << tree;
+ * */
+template <class T, std::size_t N>
+inline std::ostream& operator<<(std::ostream& os, const ConstexprTree<T, N>& tree) {
+    return tree.print(os);
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _CONSTEXPRTREE_HPP_
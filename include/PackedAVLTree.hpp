@@ -0,0 +1,486 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+/**
+ * @file: PackedAVLTree.hpp
+ * 
+ * Define a AVL Tree whose nodes hold no height: the balance factor (-1, 0, +1)
+ * is packed in the low bit of each child pointer (left bit set: left sub-tree
+ * taller, right bit set: right sub-tree taller), which is always zero for
+ * aligned nodes. The node is one word smaller than an AVLNode and balancing
+ * only reads the nodes on the path and the ones being rotated, never the
+ * heights of their children. Insert and remove are iterative, over a fixed
+ * size path, and stop retracing as soon as a sub-tree keeps its height.
+ * @see description in AVLTree.hpp
+ * 
+ * @example:
+ * PackedAVLTree<T> avl;
+ * avl.insert(t1)  // ou avl << t2;
+ * avl.remove(t1)
+ * T *t = avl.get(t2);
+ * avl.print(cout, INORDER);  // ou cout << avl;
+ * 
+ * */
+
+#ifndef _PACKEDAVLTREE_HPP_
+#define _PACKEDAVLTREE_HPP_
+
+#include <memory>
+#include <utility>
+#include <ostream>
+#include <cstdint>
+#include <vector>
+#include "BSTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+/** Node of PackedAVLTree: children and balance factor in two words */
+template <class T>
+struct PackedAVLNode : public base::Node<T, PackedAVLNode> {
+    static constexpr std::uintptr_t TAG = 1;  // the balance bit of a link
+
+    using base::Node<T, PackedAVLNode>::Node;
+    ~PackedAVLNode() {}
+
+    PackedAVLNode* child(int dir) const {
+        return reinterpret_cast<PackedAVLNode*>(links[dir] & ~TAG);
+    }
+    PackedAVLNode* left() const { return child(0); }
+    PackedAVLNode* right() const { return child(1); }
+    void setChild(int dir, PackedAVLNode *node) {
+        links[dir] = reinterpret_cast<std::uintptr_t>(node) | (links[dir] & TAG);
+    }
+    /** right sub-tree height minus left sub-tree height */
+    int balance() const {
+        return static_cast<int>(links[1] & TAG) - static_cast<int>(links[0] & TAG);
+    }
+    void setBalance(int bf) {
+        links[0] = (links[0] & ~TAG) | (bf < 0);
+        links[1] = (links[1] & ~TAG) | (bf > 0);
+    }
+
+    std::uintptr_t links[2] = {0, 0};  // left and right, tagged
+};
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * AVL Tree with packed balance factors
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T>
+class PackedAVLTree : public base::Tree<T, PackedAVLNode> {
+    using Base = base::Tree<T, PackedAVLNode>;
+
+ public:
+    using Node = PackedAVLNode<T>;  // aliases for the node type
+    static constexpr int MAX_HEIGHT = 96;  // above any AVL tree that fits in memory
+    static_assert(alignof(PackedAVLNode<T>) > PackedAVLNode<T>::TAG,
+                  "the balance bit needs aligned nodes");
+
+    PackedAVLTree() : Base() {}
+    PackedAVLTree(const PackedAVLTree&) = delete;  // no deep copy (yet), the nodes would be shared
+    PackedAVLTree(PackedAVLTree &&other) noexcept : Base() { std::swap(root, other.root); }
+    virtual ~PackedAVLTree() { destroy(root); }
+    PackedAVLTree& operator=(const PackedAVLTree&) = delete;
+    PackedAVLTree& operator=(PackedAVLTree &&other) noexcept;
+
+    /* External Methods */
+    // bool Tree::isEmpty() const;
+    void clear() override;
+    T* get(T key) const override;
+    T* getMax() const;
+    T* getMin() const;
+    bool insert(T key) override;
+    std::unique_ptr<T> remove(T key) override;
+    std::ostream& print(std::ostream& os, eOrder order = INORDER) const;
+
+    template <class _T> friend PackedAVLTree<_T>& operator<<(PackedAVLTree<_T>& avl, _T key);
+    template <class _T> friend std::ostream& operator<<(std::ostream& os,
+                                                        const PackedAVLTree<_T>& avl);
+
+ protected:
+    using Base::root;
+
+    /* Internal Methods */
+    void destroy(Node *node);
+    Node* extreme(int dir) const;
+    void replace(Node **path, int *dirs, int i, Node *node);
+    Node* rotate(Node *node, int bf, bool *shrunk);
+    void inorder(std::ostream& os, const Node *node) const;
+    void preorder(std::ostream& os, const Node *node) const;
+    void postorder(std::ostream& os, const Node *node) const;
+    void levelorder(std::ostream& os, const Node *node) const;
+};
+
+
+
+
+
+/**
+ * >> PackedAVLTree implementation <<
+ * */
+
+/**
+ * Take the elements of another tree in O(1), leaving it empty
+ * */
+template <class T>
+PackedAVLTree<T>& PackedAVLTree<T>::operator=(PackedAVLTree &&other) noexcept {
+    if (this != &other) {
+        clear();
+        std::swap(root, other.root);
+    }
+    return *this;
+}
+
+/**
+ * Clear the tree, deleting all nodes
+ * */
+template <class T>
+void PackedAVLTree<T>::clear() {
+    destroy(root);
+    root = nullptr;
+}
+
+/**
+ * Delete a node and its sub-trees
+ * @see clear()
+ * */
+template <class T>
+void PackedAVLTree<T>::destroy(Node *node) {
+    if (node != nullptr) {
+        destroy(node->left());
+        destroy(node->right());
+        delete node;
+    }
+}
+
+/**
+ * Search for a element, from root
+ * @return a pointer to the element, or nullptr if it does not exist
+ * */
+template <class T>
+T* PackedAVLTree<T>::get(T key) const {
+    const std::uint64_t prefix = base::KeyPrefix<T>::of(key);
+    for (Node *node = root; node != nullptr; ) {
+        const int cmp = base::compare(key, prefix, *node);
+        if (cmp < 0) {
+            node = node->left();
+        } else if (cmp > 0) {
+            node = node->right();
+        } else {
+            return &node->key;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * The greater element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T>
+T* PackedAVLTree<T>::getMax() const {
+    Node *node = extreme(1);
+    return node ? &node->key : nullptr;
+}
+
+/**
+ * The lesser element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T>
+T* PackedAVLTree<T>::getMin() const {
+    Node *node = extreme(0);
+    return node ? &node->key : nullptr;
+}
+
+/**
+ * Last node down the left (dir 0) or right (dir 1) spine
+ * */
+template <class T>
+auto PackedAVLTree<T>::extreme(int dir) const -> Node* {
+    Node *node = root;
+    if (node != nullptr)
+        while (node->child(dir) != nullptr) node = node->child(dir);
+    return node;
+}
+
+/**
+ * Insert a element in the tree. Retracing goes up while sub-trees grow:
+ * it stops at the first node that becomes balanced, or after one rotation
+ * @return true if element was inserted succefully, or false if it already exists
+ * */
+template <class T>
+bool PackedAVLTree<T>::insert(T key) {
+    Node *path[MAX_HEIGHT];
+    int dirs[MAX_HEIGHT];
+    int depth = 0;
+    const std::uint64_t prefix = base::KeyPrefix<T>::of(key);
+    for (Node *node = root; node != nullptr; ++depth) {
+        const int cmp = base::compare(key, prefix, *node);
+        if (cmp < 0) {
+            dirs[depth] = 0;
+        } else if (cmp > 0) {
+            dirs[depth] = 1;
+        } else {
+            return false;
+        }
+        path[depth] = node;
+        node = node->child(dirs[depth]);
+    }
+    replace(path, dirs, depth, new Node(key));
+
+    while (depth-- > 0) {  // the sub-tree on side dirs[depth] grew
+        Node *node = path[depth];
+        int bf = node->balance() + (dirs[depth] ? 1 : -1);
+        if (bf == 0) {
+            node->setBalance(0);
+            break;
+        }
+        if (bf == 1 || bf == -1) {
+            node->setBalance(bf);
+            continue;
+        }
+        replace(path, dirs, depth, rotate(node, bf, nullptr));
+        break;
+    }
+    return true;
+}
+
+/**
+ * Remove a element from the tree. With two children, the node is replaced by
+ * its successor node (relinked, other elements never move to another node).
+ * Retracing goes up while sub-trees shrink.
+ * @return a pointer to the removed element, or nullptr if it does not exist
+ * */
+template <class T>
+std::unique_ptr<T> PackedAVLTree<T>::remove(T key) {
+    Node *path[MAX_HEIGHT];
+    int dirs[MAX_HEIGHT];
+    int depth = 0;
+    Node *node = root;
+    const std::uint64_t prefix = base::KeyPrefix<T>::of(key);
+    for (;; ++depth) {
+        if (node == nullptr) return nullptr;
+        const int cmp = base::compare(key, prefix, *node);
+        if (cmp < 0) {
+            dirs[depth] = 0;
+        } else if (cmp > 0) {
+            dirs[depth] = 1;
+        } else {
+            break;
+        }
+        path[depth] = node;
+        node = node->child(dirs[depth]);
+    }
+
+    const int at = depth;
+    if (node->right() == nullptr) {
+        replace(path, dirs, at, node->left());
+    } else {
+        path[depth] = node;  // replaced below by the successor
+        dirs[depth++] = 1;
+        Node *next = node->right();
+        while (next->left() != nullptr) {
+            path[depth] = next;
+            dirs[depth++] = 0;
+            next = next->left();
+        }
+        if (depth - 1 == at) {  // the successor is the right child
+            next->setChild(0, node->left());
+        } else {
+            path[depth - 1]->setChild(0, next->right());
+            next->setChild(0, node->left());
+            next->setChild(1, node->right());
+        }
+        next->setBalance(node->balance());
+        replace(path, dirs, at, next);
+        path[at] = next;
+    }
+
+    bool shrunk = true;
+    while (shrunk && depth-- > 0) {  // the sub-tree on side dirs[depth] shrank
+        Node *parent = path[depth];
+        int bf = parent->balance() - (dirs[depth] ? 1 : -1);
+        if (bf == 1 || bf == -1) {
+            parent->setBalance(bf);
+            shrunk = false;
+        } else if (bf == 0) {
+            parent->setBalance(0);
+        } else {
+            replace(path, dirs, depth, rotate(parent, bf, &shrunk));
+        }
+    }
+
+    auto keyptr = std::make_unique<T>(std::move(node->key));
+    delete node;
+    return keyptr;
+}
+
+/**
+ * Link node in the place of path[i]: as root, or as the child of path[i - 1]
+ * on side dirs[i - 1]
+ * */
+template <class T>
+void PackedAVLTree<T>::replace(Node **path, int *dirs, int i, Node *node) {
+    if (i == 0) {
+        root = node;
+    } else {
+        path[i - 1]->setChild(dirs[i - 1], node);
+    }
+}
+
+/**
+ * Single or double rotation of a node whose balance factor went to bf = +-2,
+ * setting the factors of the rotated nodes from their old ones only
+ * @param shrunk: set to whether the sub-tree lost height (removal), may be null
+ * @return the new root of the sub-tree
+ * */
+template <class T>
+auto PackedAVLTree<T>::rotate(Node *node, int bf, bool *shrunk) -> Node* {
+    const int dir = bf > 0 ? 1 : 0;  // taller side
+    const int sign = bf > 0 ? 1 : -1;
+    Node *child = node->child(dir);
+    const int childBf = child->balance() * sign;
+
+    if (childBf >= 0) {  // single rotation
+        node->setChild(dir, child->child(!dir));
+        child->setChild(!dir, node);
+        if (childBf == 0) {  // only after a removal: the height is kept
+            node->setBalance(sign);
+            child->setBalance(-sign);
+        } else {
+            node->setBalance(0);
+            child->setBalance(0);
+        }
+        if (shrunk) *shrunk = childBf != 0;
+        return child;
+    }
+
+    Node *grand = child->child(!dir);  // double rotation
+    const int grandBf = grand->balance() * sign;
+    node->setChild(dir, grand->child(!dir));
+    child->setChild(!dir, grand->child(dir));
+    grand->setChild(!dir, node);
+    grand->setChild(dir, child);
+    node->setBalance(grandBf > 0 ? -sign : 0);
+    child->setBalance(grandBf < 0 ? sign : 0);
+    grand->setBalance(0);
+    if (shrunk) *shrunk = true;
+    return grand;
+}
+
+/**
+ * Print to console in a given order
+ * */
+template <class T>
+std::ostream& PackedAVLTree<T>::print(std::ostream& os, eOrder order) const {
+    switch (order) {
+        case INORDER:
+            inorder(os, root);
+            break;
+        case PREORDER:
+            preorder(os, root);
+            break;
+        case POSTORDER:
+            postorder(os, root);
+            break;
+        case LEVELORDER:
+            levelorder(os, root);
+            break;
+    }
+    return os;
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T>
+void PackedAVLTree<T>::inorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    inorder(os, node->left());
+    os << *node << " ";
+    inorder(os, node->right());
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T>
+void PackedAVLTree<T>::preorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    os << *node << " ";
+    preorder(os, node->left());
+    preorder(os, node->right());
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T>
+void PackedAVLTree<T>::postorder(std::ostream& os, const Node *node) const {
+    if (node == nullptr) return;
+    postorder(os, node->left());
+    postorder(os, node->right());
+    os << *node << " ";
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T>
+void PackedAVLTree<T>::levelorder(std::ostream& os, const Node *node) const {
+    std::vector<const Node*> level, next;
+    if (node != nullptr) level.push_back(node);
+    while (!level.empty()) {
+        for (const Node *n : level) {
+            os << *n << " ";
+            if (n->left() != nullptr) next.push_back(n->left());
+            if (n->right() != nullptr) next.push_back(n->right());
+        }
+        level.swap(next);
+        next.clear();
+    }
+}
+
+/**
+ * Overloading for insertion like: avl << key;
+ * */
+template <class T>
+inline PackedAVLTree<T>& operator<<(PackedAVLTree<T>& avl, T key) {
+    avl.insert(key);
+    return avl;
+}
+
+/**
+ * Overloading for printing like: std::cout << avl;
+ * */
+template <class T>
+inline std::ostream& operator<<(std::ostream& os, const PackedAVLTree<T>& avl) {
+    avl.inorder(os, avl.root);
+    return os;
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _PACKEDAVLTREE_HPP_
@@ -0,0 +1,447 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+
+/**
+ * @file: SmallAVLTree.hpp
+ *
+ * Define a AVL Tree that keeps its first N elements in a sorted array inside
+ * the tree object: no node, no allocation and a linear search (a branchless
+ * count, vectorized by the compiler for arithmetic keys) that beats a pointer
+ * chase at that size. The (N + 1)th insertion promotes the elements to an
+ * AVLTree and the tree works as one from there; once removals take it down to
+ * N / 2 elements they are moved back to the array (the gap keeps a size going
+ * up and down around N from converting at every operation).
+ * @see description in AVLTree.hpp
+ *
+ * @example:
+ * SmallAVLTree<T> avl;  // up to 16 elements in place, SmallAVLTree<T, 32> for 32
+ * avl.insert(t1)  // ou avl << t2;
+ * avl.remove(t1)
+ * T *t = avl.get(t2);
+ * for (const T& t : avl) ...
+ * avl.print(cout, INORDER);  // ou cout << avl;
+ *
+ * */
+
+#ifndef _SMALLAVLTREE_HPP_
+#define _SMALLAVLTREE_HPP_
+
+#include <memory>
+#include <utility>
+#include <ostream>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include "AVLTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+namespace base {
+
+    /**
+     * Place of an element in the array of SmallAVLTree, constructed only while
+     * in use. Arithmetic keys are always there (zero when free), so a search
+     * can read all the slots.
+     * */
+    template <class T>
+    union SmallSlot {
+        T key;
+        SmallSlot() { if constexpr (std::is_arithmetic<T>::value) new (&key) T(); }
+        ~SmallSlot() {}
+    };
+
+}  // namespace base
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * AVL Tree with small-size optimization
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T, std::size_t N = 16>
+class SmallAVLTree {
+    static_assert(N > 0, "the array holds at least one element");
+
+ public:
+    using Tree = AVLTree<T>;  // holds the elements past N
+
+    /**
+     * In-order iterator over the keys: an index in the array, or a position
+     * in the AVLTree once promoted. Any change to the tree invalidates it.
+     * */
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() {}
+        reference operator*() const { return small ? small->slots[at].key : *it; }
+        pointer operator->() const { return &**this; }
+        iterator& operator++() { if (small) ++at; else ++it; return *this; }
+        iterator operator++(int) { iterator i = *this; ++*this; return i; }
+        bool operator==(const iterator& other) const { return at == other.at && it == other.it; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+     private:
+        friend class SmallAVLTree;
+        iterator(const SmallAVLTree *small, std::size_t at) : small(small), at(at) {}
+        explicit iterator(typename Tree::iterator it) : it(it) {}
+        const SmallAVLTree *small = nullptr;  // nullptr once promoted
+        std::size_t at = 0;
+        typename Tree::iterator it;
+    };
+
+    SmallAVLTree() {}
+    SmallAVLTree(const SmallAVLTree &other) : tree(other.tree) { copy(other); }
+    SmallAVLTree(SmallAVLTree &&other) noexcept : tree(std::move(other.tree)) { take(other); }
+    ~SmallAVLTree() { destroy(); }
+    SmallAVLTree& operator=(const SmallAVLTree &other);
+    SmallAVLTree& operator=(SmallAVLTree &&other) noexcept;
+
+    /* External Methods */
+    operator bool() const { return !isEmpty(); }
+    bool isEmpty() const { return count == 0 && tree.isEmpty(); }
+    bool isPromoted() const { return !tree.isEmpty(); }
+    std::size_t size() const { return isPromoted() ? tree.size() : count; }
+    static constexpr std::size_t capacity() { return N; }  // of the array
+    void clear();
+    T* get(T key) const;
+    T* getMax() const;
+    T* getMin() const;
+    bool insert(T key);
+    std::unique_ptr<T> remove(T key);
+    std::unique_ptr<T> removeMax();
+    std::unique_ptr<T> removeMin();
+    iterator begin() const;
+    iterator end() const;
+    std::ostream& print(std::ostream& os, eOrder order = INORDER) const;
+
+    template <class _T, std::size_t _N>
+    friend SmallAVLTree<_T, _N>& operator<<(SmallAVLTree<_T, _N>& avl, _T key);
+    template <class _T, std::size_t _N>
+    friend std::ostream& operator<<(std::ostream& os, const SmallAVLTree<_T, _N>& avl);
+
+ protected:
+    mutable base::SmallSlot<T> slots[N];  // sorted, the first 'count' in use
+    std::size_t count = 0;
+    Tree tree;  // empty until promoted
+
+    /* Internal Methods */
+    std::size_t lowerBound(const T &key) const;
+    std::unique_ptr<T> take(std::size_t at);
+    void destroy();
+    void copy(const SmallAVLTree &other);
+    void take(SmallAVLTree &other);
+    void promote();
+    void demote();
+};
+
+
+
+
+
+/**
+ * >> SmallAVLTree implementation <<
+ * */
+
+/**
+ * Replace the elements by a copy of another tree's
+ * */
+template <class T, std::size_t N>
+SmallAVLTree<T, N>& SmallAVLTree<T, N>::operator=(const SmallAVLTree &other) {
+    if (this != &other) {
+        destroy();
+        tree = other.tree;
+        copy(other);
+    }
+    return *this;
+}
+
+/**
+ * Replace the elements by another tree's, leaving it empty. O(1) once
+ * promoted, the elements in the array are moved one by one
+ * */
+template <class T, std::size_t N>
+SmallAVLTree<T, N>& SmallAVLTree<T, N>::operator=(SmallAVLTree &&other) noexcept {
+    if (this != &other) {
+        destroy();
+        tree = std::move(other.tree);
+        take(other);
+    }
+    return *this;
+}
+
+/**
+ * Clear the tree, back to the array
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::clear() {
+    destroy();
+    tree.clear();
+}
+
+/**
+ * Destroy the elements in the array
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::destroy() {
+    for (std::size_t i = 0; i < count; ++i) slots[i].key.~T();
+    count = 0;
+}
+
+/**
+ * Copy the elements in the array of another tree (this one's is empty)
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::copy(const SmallAVLTree &other) {
+    for (; count < other.count; ++count) new (&slots[count].key) T(other.slots[count].key);
+}
+
+/**
+ * Move the elements in the array of another tree (this one's is empty)
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::take(SmallAVLTree &other) {
+    for (; count < other.count; ++count) new (&slots[count].key) T(std::move(other.slots[count].key));
+    other.destroy();
+}
+
+/**
+ * Index of the first element in the array not less than key (count if none).
+ * Arithmetic keys are counted without branches over all N slots, a loop of
+ * fixed length the compiler vectorizes; others by binary search.
+ * */
+template <class T, std::size_t N>
+std::size_t SmallAVLTree<T, N>::lowerBound(const T &key) const {
+    if constexpr (std::is_arithmetic<T>::value) {
+        const unsigned used = static_cast<unsigned>(count);
+        unsigned at = 0;
+        for (unsigned i = 0; i < N; ++i) at += (slots[i].key < key) & (i < used);
+        return at;
+    } else {
+        std::size_t lo = 0, hi = count;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (slots[mid].key < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+}
+
+/**
+ * Search for a element, in the array or from root
+ * @return a pointer to the element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t N>
+T* SmallAVLTree<T, N>::get(T key) const {
+    if (isPromoted()) return tree.get(key);
+    std::size_t at = lowerBound(key);
+    return at < count && !(key < slots[at].key) ? &slots[at].key : nullptr;
+}
+
+/**
+ * The greater element in the tree, in O(1)
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+T* SmallAVLTree<T, N>::getMax() const {
+    if (isPromoted()) return tree.getMax();
+    return count ? &slots[count - 1].key : nullptr;
+}
+
+/**
+ * The lesser element in the tree, in O(1)
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+T* SmallAVLTree<T, N>::getMin() const {
+    if (isPromoted()) return tree.getMin();
+    return count ? &slots[0].key : nullptr;
+}
+
+/**
+ * Insert a element in the tree: in place in the array while it has room,
+ * else promoting the elements to the AVLTree first
+ * @return true if element was inserted succefully, or false if it already exists
+ * */
+template <class T, std::size_t N>
+bool SmallAVLTree<T, N>::insert(T key) {
+    if (isPromoted()) return tree.insert(key);
+    std::size_t at = lowerBound(key);
+    if (at < count && !(key < slots[at].key)) return false;
+    if (count == N) {
+        promote();
+        return tree.insert(key);
+    }
+    if (at == count) {
+        new (&slots[count].key) T(std::move(key));
+    } else {  // shift the greater elements one place up
+        new (&slots[count].key) T(std::move(slots[count - 1].key));
+        for (std::size_t i = count - 1; i > at; --i) slots[i].key = std::move(slots[i - 1].key);
+        slots[at].key = std::move(key);
+    }
+    ++count;
+    return true;
+}
+
+/**
+ * Remove a element from the tree. Once promoted, getting down to N / 2
+ * elements moves them back to the array.
+ * @return a pointer to the removed element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t N>
+std::unique_ptr<T> SmallAVLTree<T, N>::remove(T key) {
+    if (isPromoted()) {
+        auto keyptr = tree.remove(key);
+        if (keyptr && tree.size() <= N / 2) demote();
+        return keyptr;
+    }
+    std::size_t at = lowerBound(key);
+    if (at == count || key < slots[at].key) return nullptr;
+    return take(at);
+}
+
+/**
+ * Remove the greater element in the tree
+ * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+std::unique_ptr<T> SmallAVLTree<T, N>::removeMax() {
+    if (isPromoted()) {
+        auto keyptr = tree.removeMax();
+        if (tree.size() <= N / 2) demote();
+        return keyptr;
+    }
+    return count ? take(count - 1) : nullptr;
+}
+
+/**
+ * Remove the lesser element in the tree
+ * @return a pointer to the removed element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+std::unique_ptr<T> SmallAVLTree<T, N>::removeMin() {
+    if (isPromoted()) {
+        auto keyptr = tree.removeMin();
+        if (tree.size() <= N / 2) demote();
+        return keyptr;
+    }
+    return count ? take(0) : nullptr;
+}
+
+/**
+ * Move out the element at an index of the array, shifting the greater ones down
+ * */
+template <class T, std::size_t N>
+std::unique_ptr<T> SmallAVLTree<T, N>::take(std::size_t at) {
+    auto keyptr = std::make_unique<T>(std::move(slots[at].key));
+    for (std::size_t i = at + 1; i < count; ++i) slots[i - 1].key = std::move(slots[i].key);
+    slots[--count].key.~T();
+    return keyptr;
+}
+
+/**
+ * Move the (full) array to the AVLTree, in order: each insertion is hinted
+ * by the previous one, so it starts at the right end instead of at root
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::promote() {
+    auto hint = tree.end();
+    for (std::size_t i = 0; i < count; ++i)
+        hint = tree.insert(hint, std::move(slots[i].key)).first;
+    destroy();
+}
+
+/**
+ * Move the elements of the AVLTree back to the (empty) array
+ * */
+template <class T, std::size_t N>
+void SmallAVLTree<T, N>::demote() {
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++count)
+        new (&slots[count].key) T(std::move(const_cast<T&>(*it)));
+    tree.clear();
+}
+
+/**
+ * Position of the lesser element, end() if the tree is empty
+ * */
+template <class T, std::size_t N>
+auto SmallAVLTree<T, N>::begin() const -> iterator {
+    return isPromoted() ? iterator(tree.begin()) : iterator(this, 0);
+}
+
+/**
+ * Position after the greater element
+ * */
+template <class T, std::size_t N>
+auto SmallAVLTree<T, N>::end() const -> iterator {
+    return isPromoted() ? iterator(tree.end()) : iterator(this, count);
+}
+
+/**
+ * Print to console in a given order. The elements in the array have no
+ * tree shape: they print in order, whatever the order asked.
+ * */
+template <class T, std::size_t N>
+std::ostream& SmallAVLTree<T, N>::print(std::ostream& os, eOrder order) const {
+    if (isPromoted()) return tree.print(os, order);
+    for (std::size_t i = 0; i < count; ++i) os << slots[i].key << " ";
+    return os;
+}
+
+/**
+ * Overloading for insertion like: avl << key;
+ * */
+template <class T, std::size_t N>
+inline SmallAVLTree<T, N>& operator<<(SmallAVLTree<T, N>& avl, T key) {
+    avl.insert(key);
+    return avl;
+}
+
+/**
+ * Overloading for printing like: std::cout << avl;
+ * */
+template <class T, std::size_t N>
+inline std::ostream& operator<<(std::ostream& os, const SmallAVLTree<T, N>& avl) {
+    return avl.print(os, INORDER);
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _SMALLAVLTREE_HPP_
@@ -0,0 +1,574 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+/**
+ * @file: StaticAVLTree.hpp
+ *
+ * Define a AVL Tree of fixed capacity that never touches the heap: its N
+ * nodes live in an array inside the tree object, children are indices in
+ * that array (8, 16 or 32 bits, the smallest that holds N) and removed nodes
+ * go to a free list threaded through the unused slots. A full tree refuses
+ * insertions (FULL) instead of allocating. Insert and remove are iterative,
+ * over a path whose length is bounded by the largest AVL height for N nodes.
+ * @see description in AVLTree.hpp
+ *
+ * @example:
+ * StaticAVLTree<T, 64> avl;  // up to 64 elements, in place
+ * if (avl.insert(t1) == FULL) ...  // ou avl << t2;
+ * avl.remove(t1);  // ou avl.remove(t1, &out), moving the element out
+ * const T *t = avl.get(t2);
+ * for (const T& t : avl) ...
+ * avl.print(cout, INORDER);  // ou cout << avl;
+ *
+ * */
+
+#ifndef _STATICAVLTREE_HPP_
+#define _STATICAVLTREE_HPP_
+
+#include <utility>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include "BSTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+/** Results of an insertion in a tree of fixed capacity */
+enum eInsert {
+    INSERTED,  // the element is now in the tree
+    EXISTS,    // an equal element was already there, nothing changed
+    FULL       // no free node left, nothing changed
+};
+
+
+/**
+ * Node of StaticAVLTree: children are indices in the tree's array (the
+ * capacity for none). The key is only constructed while the node is in use,
+ * a free node holds the next index of the free list in its place.
+ * */
+template <class T, class Index>
+struct StaticAVLNode {
+    union {
+        T key;
+        Index next;
+    };
+    Index child[2];  // left and right
+    std::uint8_t height;
+
+    StaticAVLNode() {}
+    ~StaticAVLNode() {}
+};
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * AVL Tree of fixed capacity, in place
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T, std::size_t N>
+class StaticAVLTree {
+    static_assert(N > 0 && N < 0xFFFFFFFF, "capacity out of the 32-bit indices");
+
+ public:
+    /** Smallest index type that holds every index and NIL */
+    using Index = std::conditional_t<N < 0xFF, std::uint8_t,
+                  std::conditional_t<N < 0xFFFF, std::uint16_t, std::uint32_t>>;
+    using Node = StaticAVLNode<T, Index>;  // aliases for the node type
+    static constexpr Index NIL = static_cast<Index>(N);  // no node
+    static constexpr int MAX_HEIGHT = [] {  // of an AVL tree of N nodes
+        std::size_t fewer = 0, fewest = 1;  // least nodes of a tree of height h, h + 1
+        int h = 0;
+        for (; fewest <= N; ++h) {
+            std::size_t next = fewest + fewer + 1;
+            fewer = fewest;
+            fewest = next;
+        }
+        return h;
+    }();
+
+    /**
+     * In-order iterator over the keys, holding the path (indices) from root
+     * to its node. Any change to the tree invalidates it.
+     * */
+    class iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() {}
+        reference operator*() const { return tree->nodes[path[depth - 1]].key; }
+        pointer operator->() const { return &tree->nodes[path[depth - 1]].key; }
+        iterator& operator++();
+        iterator operator++(int) { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator& other) const { return node() == other.node(); }
+        bool operator!=(const iterator& other) const { return node() != other.node(); }
+
+     private:
+        friend class StaticAVLTree;
+        explicit iterator(const StaticAVLTree *tree) : tree(tree) { descend(tree->root); }
+        Index node() const { return depth ? path[depth - 1] : NIL; }
+        void descend(Index node);
+        const StaticAVLTree *tree = nullptr;
+        Index path[MAX_HEIGHT];
+        int depth = 0;  // 0 for end()
+    };
+
+    StaticAVLTree() {}
+    StaticAVLTree(const StaticAVLTree&) = delete;
+    ~StaticAVLTree() { destroy(root); }
+    StaticAVLTree& operator=(const StaticAVLTree&) = delete;
+
+    /* External Methods */
+    operator bool() const { return root != NIL; }
+    bool isEmpty() const { return root == NIL; }
+    bool isFull() const { return count == N; }
+    std::size_t size() const { return count; }
+    static constexpr std::size_t capacity() { return N; }
+    void clear();
+    const T* get(const T &key) const;
+    const T* getMax() const;
+    const T* getMin() const;
+    eInsert insert(T key);
+    bool remove(const T &key, T *out = nullptr);
+    iterator begin() const { return iterator(this); }
+    iterator end() const { return iterator(); }
+    std::ostream& print(std::ostream& os, eOrder order = INORDER) const;
+
+    template <class _T, std::size_t _N>
+    friend StaticAVLTree<_T, _N>& operator<<(StaticAVLTree<_T, _N>& avl, _T key);
+    template <class _T, std::size_t _N>
+    friend std::ostream& operator<<(std::ostream& os, const StaticAVLTree<_T, _N>& avl);
+
+ protected:
+    Node nodes[N];
+    Index root = NIL;
+    Index free = NIL;  // head of the free list
+    Index used = 0;  // slots ever used: the ones from here on are free too
+    Index count = 0;
+
+    /* Internal Methods */
+    Index allocate();
+    void release(Index node);
+    void destroy(Index node);
+    int height(Index node) const { return node == NIL ? 0 : nodes[node].height; }
+    void update(Index node);
+    Index rotate(Index node, int dir);
+    Index balance(Index node);
+    void retrace(Index *path, int *dirs, int depth);
+    void replace(Index *path, int *dirs, int i, Index node);
+    Index extreme(int dir) const;
+    void inorder(std::ostream& os, Index node) const;
+    void preorder(std::ostream& os, Index node) const;
+    void postorder(std::ostream& os, Index node) const;
+    void level(std::ostream& os, Index node, int depth) const;
+};
+
+
+
+
+
+/**
+ * >> StaticAVLTree implementation <<
+ * */
+
+/**
+ * Clear the tree, destroying all elements, in O(n)
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::clear() {
+    destroy(root);
+    root = free = NIL;
+    used = count = 0;
+}
+
+/**
+ * Destroy the elements of a sub-tree (nothing to do for trivial types)
+ * @see clear()
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::destroy(Index node) {
+    if constexpr (!std::is_trivially_destructible<T>::value) {
+        if (node != NIL) {
+            destroy(nodes[node].child[0]);
+            destroy(nodes[node].child[1]);
+            nodes[node].key.~T();
+        }
+    }
+}
+
+/**
+ * Take a free node: from the free list, else the first never used slot
+ * @return its index, or NIL when the tree is full
+ * */
+template <class T, std::size_t N>
+auto StaticAVLTree<T, N>::allocate() -> Index {
+    if (free != NIL) {
+        Index node = free;
+        free = nodes[node].next;
+        return node;
+    }
+    return used < N ? used++ : NIL;
+}
+
+/**
+ * Give back a node whose element was destroyed
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::release(Index node) {
+    nodes[node].next = free;
+    free = node;
+}
+
+/**
+ * Search for a element, from root
+ * @return a pointer to the element, or nullptr if it does not exist
+ * */
+template <class T, std::size_t N>
+const T* StaticAVLTree<T, N>::get(const T &key) const {
+    for (Index node = root; node != NIL; ) {
+        const Node &n = nodes[node];
+        if (key < n.key) {
+            node = n.child[0];
+        } else if (n.key < key) {
+            node = n.child[1];
+        } else {
+            return &n.key;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * The greater element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+const T* StaticAVLTree<T, N>::getMax() const {
+    Index node = extreme(1);
+    return node != NIL ? &nodes[node].key : nullptr;
+}
+
+/**
+ * The lesser element in the tree
+ * @return a pointer to the element, or nullptr if it does not exist (empty tree)
+ * */
+template <class T, std::size_t N>
+const T* StaticAVLTree<T, N>::getMin() const {
+    Index node = extreme(0);
+    return node != NIL ? &nodes[node].key : nullptr;
+}
+
+/**
+ * Last node down the left (dir 0) or right (dir 1) spine
+ * */
+template <class T, std::size_t N>
+auto StaticAVLTree<T, N>::extreme(int dir) const -> Index {
+    Index node = root;
+    if (node != NIL)
+        while (nodes[node].child[dir] != NIL) node = nodes[node].child[dir];
+    return node;
+}
+
+/**
+ * Insert a element in the tree, in a free node. Retracing goes up while
+ * sub-trees grow, rotating where they lean too much
+ * @return INSERTED, EXISTS if it already exists or FULL if no node is free
+ * */
+template <class T, std::size_t N>
+eInsert StaticAVLTree<T, N>::insert(T key) {
+    Index path[MAX_HEIGHT];
+    int dirs[MAX_HEIGHT];
+    int depth = 0;
+    for (Index node = root; node != NIL; ++depth) {
+        const Node &n = nodes[node];
+        if (key < n.key) {
+            dirs[depth] = 0;
+        } else if (n.key < key) {
+            dirs[depth] = 1;
+        } else {
+            return EXISTS;
+        }
+        path[depth] = node;
+        node = n.child[dirs[depth]];
+    }
+    Index node = allocate();
+    if (node == NIL) return FULL;
+    new (&nodes[node].key) T(std::move(key));
+    nodes[node].child[0] = nodes[node].child[1] = NIL;
+    nodes[node].height = 1;
+    replace(path, dirs, depth, node);
+    retrace(path, dirs, depth);
+    ++count;
+    return INSERTED;
+}
+
+/**
+ * Remove a element from the tree. With two children, the node is replaced by
+ * its successor node (relinked, other elements never move to another node).
+ * Retracing goes up while sub-trees shrink.
+ * @param out: where to move the removed element, if not null
+ * @return true if the element was removed, false if it does not exist
+ * */
+template <class T, std::size_t N>
+bool StaticAVLTree<T, N>::remove(const T &key, T *out) {
+    Index path[MAX_HEIGHT];
+    int dirs[MAX_HEIGHT];
+    int depth = 0;
+    Index node = root;
+    for (;; ++depth) {
+        if (node == NIL) return false;
+        const Node &n = nodes[node];
+        if (key < n.key) {
+            dirs[depth] = 0;
+        } else if (n.key < key) {
+            dirs[depth] = 1;
+        } else {
+            break;
+        }
+        path[depth] = node;
+        node = n.child[dirs[depth]];
+    }
+
+    Node &n = nodes[node];
+    const int at = depth;
+    if (n.child[1] == NIL) {
+        replace(path, dirs, at, n.child[0]);
+    } else {
+        path[depth] = node;  // replaced below by the successor
+        dirs[depth++] = 1;
+        Index next = n.child[1];
+        while (nodes[next].child[0] != NIL) {
+            path[depth] = next;
+            dirs[depth++] = 0;
+            next = nodes[next].child[0];
+        }
+        if (depth - 1 == at) {  // the successor is the right child
+            nodes[next].child[0] = n.child[0];
+        } else {
+            nodes[path[depth - 1]].child[0] = nodes[next].child[1];
+            nodes[next].child[0] = n.child[0];
+            nodes[next].child[1] = n.child[1];
+        }
+        nodes[next].height = n.height;
+        replace(path, dirs, at, next);
+        path[at] = next;
+    }
+    retrace(path, dirs, depth);
+
+    if (out != nullptr) *out = std::move(n.key);
+    n.key.~T();
+    release(node);
+    --count;
+    return true;
+}
+
+/**
+ * Rebalance the nodes of a path from its end up (path[depth - 1] first),
+ * until a sub-tree keeps the height it had
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::retrace(Index *path, int *dirs, int depth) {
+    while (depth-- > 0) {
+        Index node = path[depth];
+        int before = nodes[node].height;
+        Index top = balance(node);
+        if (top != node) replace(path, dirs, depth, top);
+        if (nodes[top].height == before) break;
+    }
+}
+
+/**
+ * Link node in the place of path[i]: as root, or as the child of path[i - 1]
+ * on side dirs[i - 1]
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::replace(Index *path, int *dirs, int i, Index node) {
+    if (i == 0) {
+        root = node;
+    } else {
+        nodes[path[i - 1]].child[dirs[i - 1]] = node;
+    }
+}
+
+/**
+ * Recompute the height of a node from its children's
+ * */
+template <class T, std::size_t N>
+inline void StaticAVLTree<T, N>::update(Index node) {
+    int left = height(nodes[node].child[0]), right = height(nodes[node].child[1]);
+    nodes[node].height = static_cast<std::uint8_t>((left > right ? left : right) + 1);
+}
+
+/**
+ * Rotate the child on side dir up in the place of node
+ * @return the new root of the sub-tree
+ * */
+template <class T, std::size_t N>
+auto StaticAVLTree<T, N>::rotate(Index node, int dir) -> Index {
+    Index child = nodes[node].child[dir];
+    nodes[node].child[dir] = nodes[child].child[!dir];
+    nodes[child].child[!dir] = node;
+    update(node);
+    update(child);
+    return child;
+}
+
+/**
+ * Update the height of a node and rotate it (twice if its taller child leans
+ * the other way) when its sub-trees differ by more than one level
+ * @return the new root of the sub-tree
+ * */
+template <class T, std::size_t N>
+auto StaticAVLTree<T, N>::balance(Index node) -> Index {
+    update(node);
+    int bf = height(nodes[node].child[1]) - height(nodes[node].child[0]);
+    if (bf < 2 && bf > -2) return node;
+    const int dir = bf > 0 ? 1 : 0;  // taller side
+    Index child = nodes[node].child[dir];
+    if (height(nodes[child].child[!dir]) > height(nodes[child].child[dir]))
+        nodes[node].child[dir] = rotate(child, !dir);
+    return rotate(node, dir);
+}
+
+/**
+ * Walk down the left children, from node
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::iterator::descend(Index node) {
+    for (; node != NIL; node = tree->nodes[node].child[0]) path[depth++] = node;
+}
+
+/**
+ * Next element in order
+ * */
+template <class T, std::size_t N>
+auto StaticAVLTree<T, N>::iterator::operator++() -> iterator& {
+    Index right = tree->nodes[path[depth - 1]].child[1];
+    if (right != NIL) {
+        descend(right);
+    } else {  // climb while coming from a right child
+        Index child = path[--depth];
+        while (depth > 0 && tree->nodes[path[depth - 1]].child[1] == child) child = path[--depth];
+    }
+    return *this;
+}
+
+/**
+ * Print to console in a given order
+ * */
+template <class T, std::size_t N>
+std::ostream& StaticAVLTree<T, N>::print(std::ostream& os, eOrder order) const {
+    switch (order) {
+        case INORDER:
+            inorder(os, root);
+            break;
+        case PREORDER:
+            preorder(os, root);
+            break;
+        case POSTORDER:
+            postorder(os, root);
+            break;
+        case LEVELORDER:
+            for (int depth = 0; depth < height(root); ++depth) level(os, root, depth);
+            break;
+    }
+    return os;
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::inorder(std::ostream& os, Index node) const {
+    if (node == NIL) return;
+    inorder(os, nodes[node].child[0]);
+    os << nodes[node].key << " ";
+    inorder(os, nodes[node].child[1]);
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::preorder(std::ostream& os, Index node) const {
+    if (node == NIL) return;
+    os << nodes[node].key << " ";
+    preorder(os, nodes[node].child[0]);
+    preorder(os, nodes[node].child[1]);
+}
+
+/** @see print(std::ostream& os, eOrder order) */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::postorder(std::ostream& os, Index node) const {
+    if (node == NIL) return;
+    postorder(os, nodes[node].child[0]);
+    postorder(os, nodes[node].child[1]);
+    os << nodes[node].key << " ";
+}
+
+/**
+ * The nodes at a depth below node, left to right: level order without a
+ * queue (no allocation), in O(n log n) for the whole tree
+ * @see print(std::ostream& os, eOrder order)
+ * */
+template <class T, std::size_t N>
+void StaticAVLTree<T, N>::level(std::ostream& os, Index node, int depth) const {
+    if (node == NIL) return;
+    if (depth == 0) {
+        os << nodes[node].key << " ";
+        return;
+    }
+    level(os, nodes[node].child[0], depth - 1);
+    level(os, nodes[node].child[1], depth - 1);
+}
+
+/**
+ * Overloading for insertion like: avl << key;
+ * */
+template <class T, std::size_t N>
+inline StaticAVLTree<T, N>& operator<<(StaticAVLTree<T, N>& avl, T key) {
+    avl.insert(key);
+    return avl;
+}
+
+/**
+ * Overloading for printing like: std::cout << avl;
+ * */
+template <class T, std::size_t N>
+inline std::ostream& operator<<(std::ostream& os, const StaticAVLTree<T, N>& avl) {
+    avl.inorder(os, avl.root);
+    return os;
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _STATICAVLTREE_HPP_
@@ -0,0 +1,309 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+
+/**
+ * @file: StringAVLTree.hpp
+ *
+ * Define a AVL Tree of strings that owns their characters: an insertion
+ * copies the key's bytes into a bump arena of the tree (large chunks, one
+ * allocation per CHUNK bytes of keys) and the nodes hold std::string_view
+ * over them, so an insertion allocates its node and nothing else, keys sit
+ * together in memory and the nodes keep the cached prefix of string_view keys
+ * (base::KeyPrefix). Removed keys leave their bytes in the arena until
+ * compact() or clear().
+ * @see description in AVLTree.hpp
+ *
+ * @example:
+ * StringAVLTree names;
+ * names.insert("alice");  // copied in, any std::string_view
+ * const std::string_view *name = names.get("alice");
+ * std::string out;
+ * names.remove("alice", &out);  // the removed key copied out, if asked
+ * for (std::string_view name : names) ...
+ * names.compact();  // reclaim the bytes of removed keys
+ *
+ * */
+
+#ifndef _STRINGAVLTREE_HPP_
+#define _STRINGAVLTREE_HPP_
+
+#include <memory>
+#include <utility>
+#include <ostream>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+namespace base {
+
+    /**
+     * Bump allocator of string bytes: copies go one after the other in
+     * chunks of CHUNK bytes, freed all at once. Keys longer than a quarter
+     * chunk get a chunk of their own, the current one keeps its room.
+     * */
+    class StringArena {
+     public:
+        static constexpr std::size_t CHUNK = 64 * 1024;
+
+        StringArena() {}
+        StringArena(StringArena &&other) noexcept { *this = std::move(other); }
+        StringArena& operator=(StringArena &&other) noexcept;
+        std::string_view copy(std::string_view bytes);
+        void clear();
+        std::size_t capacity() const { return reserved; }  // bytes in all chunks
+        std::size_t chunks() const { return blocks.size(); }
+
+     private:
+        std::vector<std::unique_ptr<char[]>> blocks;
+        char *cursor = nullptr;  // free room of the current chunk
+        std::size_t room = 0;
+        std::size_t reserved = 0;
+    };
+
+    /**
+     * Take the chunks of another arena, leaving it empty: its copies stay
+     * valid, now owned by this one, and its next copy starts a new chunk
+     * */
+    inline StringArena& StringArena::operator=(StringArena &&other) noexcept {
+        if (this != &other) {
+            blocks = std::move(other.blocks);
+            cursor = other.cursor;
+            room = other.room;
+            reserved = other.reserved;
+            other.blocks.clear();
+            other.cursor = nullptr;
+            other.room = other.reserved = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * Copy bytes in the arena
+     * @return a view of the copy, valid until clear()
+     * */
+    inline std::string_view StringArena::copy(std::string_view bytes) {
+        if (bytes.empty()) return std::string_view();
+        if (bytes.size() > room) {
+            if (bytes.size() > CHUNK / 4) {
+                blocks.emplace_back(new char[bytes.size()]);
+                reserved += bytes.size();
+                std::memcpy(blocks.back().get(), bytes.data(), bytes.size());
+                return std::string_view(blocks.back().get(), bytes.size());
+            }
+            blocks.emplace_back(new char[CHUNK]);
+            reserved += CHUNK;
+            cursor = blocks.back().get();
+            room = CHUNK;
+        }
+        std::memcpy(cursor, bytes.data(), bytes.size());
+        std::string_view view(cursor, bytes.size());
+        cursor += bytes.size();
+        room -= bytes.size();
+        return view;
+    }
+
+    /**
+     * Free all chunks, invalidating every copy
+     * */
+    inline void StringArena::clear() {
+        blocks.clear();
+        cursor = nullptr;
+        room = reserved = 0;
+    }
+
+}  // namespace base
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * AVL Tree of strings, keys in a bump arena
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+class StringAVLTree : protected AVLTree<std::string_view> {
+    using Base = AVLTree<std::string_view>;
+
+ public:
+    using Node = Base::Node;  // aliases for the node type
+    using iterator = Base::iterator;
+
+    StringAVLTree() : Base() {}
+    StringAVLTree(const StringAVLTree&) = delete;  // no deep copy (yet), the views would be shared
+    StringAVLTree(StringAVLTree &&other) noexcept;  // the chunks move, the views hold
+    ~StringAVLTree() {}
+    StringAVLTree& operator=(const StringAVLTree&) = delete;
+    StringAVLTree& operator=(StringAVLTree &&other) noexcept;
+
+    /* External Methods */
+    using Base::operator bool;
+    using Base::isEmpty;
+    using Base::size;
+    void clear() override;
+    using Base::get;
+    using Base::getMax;
+    using Base::getMin;
+    bool insert(std::string_view key) override;
+    using Base::begin;
+    using Base::end;
+    iterator find(std::string_view key) const { return Base::find(key); }
+    bool remove(std::string_view key, std::string *out = nullptr);
+    bool removeMax(std::string *out = nullptr);
+    bool removeMin(std::string *out = nullptr);
+    void compact();
+    std::size_t arenaBytes() const { return arena.capacity(); }
+    std::size_t keyBytes() const { return liveBytes; }
+    using Base::print;
+
+    friend std::ostream& operator<<(std::ostream& os, const StringAVLTree& tree);
+
+ protected:
+    using Base::root;
+    base::StringArena arena;
+    std::size_t liveBytes = 0;  // bytes of the keys in the tree
+
+    /* Internal Methods */
+    bool release(Node *node, std::string *out);
+};
+
+
+
+
+
+/**
+ * >> StringAVLTree implementation <<
+ * */
+
+/**
+ * Take the nodes and arena of another tree, leaving it empty and usable
+ * */
+inline StringAVLTree::StringAVLTree(StringAVLTree &&other) noexcept
+    : Base(std::move(other)), arena(std::move(other.arena)), liveBytes(other.liveBytes) {
+    other.liveBytes = 0;
+}
+
+/**
+ * Replace the strings by another tree's, leaving it empty and usable
+ * */
+inline StringAVLTree& StringAVLTree::operator=(StringAVLTree &&other) noexcept {
+    if (this != &other) {
+        Base::operator=(std::move(other));
+        arena = std::move(other.arena);
+        liveBytes = other.liveBytes;
+        other.liveBytes = 0;
+    }
+    return *this;
+}
+
+/**
+ * Clear the tree, deleting all nodes and the arena
+ * */
+inline void StringAVLTree::clear() {
+    Base::clear();
+    arena.clear();
+    liveBytes = 0;
+}
+
+/**
+ * Insert a copy of a string: searched with the caller's bytes, copied in the
+ * arena only once its place is found
+ * @return true if element was inserted succefully, or false if it already exists
+ * */
+inline bool StringAVLTree::insert(std::string_view key) {
+    Path path;
+    if (seek(path, key)) return false;
+    std::string_view copy = arena.copy(key);
+    append(path, newNode(copy));
+    liveBytes += key.size();
+    return true;
+}
+
+/**
+ * Remove a string from the tree
+ * @param out: where to copy the removed string, if not null
+ * @return true if the string was removed, false if it does not exist
+ * */
+inline bool StringAVLTree::remove(std::string_view key, std::string *out) {
+    return release(detach(key), out);
+}
+
+/**
+ * Remove the greater string in the tree
+ * @return true if a string was removed, false if the tree is empty
+ * */
+inline bool StringAVLTree::removeMax(std::string *out) {
+    return release(detachExtreme(true), out);
+}
+
+/**
+ * Remove the lesser string in the tree
+ * @return true if a string was removed, false if the tree is empty
+ * */
+inline bool StringAVLTree::removeMin(std::string *out) {
+    return release(detachExtreme(false), out);
+}
+
+/**
+ * Delete a detached node, copying its key out first
+ * @return whether there was a node
+ * */
+inline bool StringAVLTree::release(Node *node, std::string *out) {
+    if (node == nullptr) return false;
+    if (out != nullptr) out->assign(node->key);
+    liveBytes -= node->key.size();
+    delete node;
+    return true;
+}
+
+/**
+ * Copy the strings still in the tree to a new arena, in order, and free the
+ * old one with the bytes of the removed keys. The nodes stay as they are.
+ * */
+inline void StringAVLTree::compact() {
+    base::StringArena fresh;
+    for (iterator it = begin(); it != end(); ++it)
+        const_cast<std::string_view&>(*it) = fresh.copy(*it);  // same bytes, same prefix
+    arena = std::move(fresh);
+}
+
+/**
+ * Overloading for printing like: std::cout << tree;
+ * */
+inline std::ostream& operator<<(std::ostream& os, const StringAVLTree& tree) {
+    return tree.print(os, INORDER);
+}
+
+
+}  // namespace trees
+
+
+#endif  // end of include guard: _STRINGAVLTREE_HPP_
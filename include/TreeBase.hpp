@@ -35,6 +35,14 @@ IN THE SOFTWARE.
 
 #include <memory>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 
 /*******************************
  * Tree Data Structures
@@ -60,12 +68,110 @@ namespace base {
         T* operator[](T key) { return get(key); }
     };
 
+    /** Largest key held in place by the nodes, @see storeInline */
+    constexpr std::size_t KEY_INLINE_MAX = 64;
+
+    /**
+     * Whether the nodes hold their key in place (keys up to KEY_INLINE_MAX
+     * bytes) or a separately allocated one, so large keys do not spread the
+     * links and heights of a descent over many cache lines. Specialize to choose:
+     * template <> struct trees::base::storeInline<Big> : std::true_type {};
+     * */
+    template <class T>
+    struct storeInline : std::integral_constant<bool, sizeof(T) <= KEY_INLINE_MAX> {};
+
+    /**
+     * Order-preserving 64-bit prefix of a key, cached in the nodes to decide
+     * comparisons without reading the key: a <= b must imply of(a) <= of(b).
+     * Disabled by default, specialize to enable:
+     * template <> struct trees::base::KeyPrefix<Big> {
+     *     static constexpr bool enabled = true;
+     *     static std::uint64_t of(const Big& key) { return key.id; }
+     * };
+     * */
+    template <class T>
+    struct KeyPrefix {
+        static constexpr bool enabled = false;
+        static std::uint64_t of(const T&) { return 0; }
+    };
+
+    /**
+     * First 8 bytes of a string as a big-endian number, zero padded: compares
+     * as memcmp() (std::string's order) on those bytes, so it orders strings
+     * that differ there and ties on the others
+     * */
+    inline std::uint64_t normalizedPrefix(const char *data, std::size_t size) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        if (size >= sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, data, sizeof(word));
+            return __builtin_bswap64(word);
+        }
+#endif
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < sizeof(prefix); ++i) {
+            prefix <<= 8;
+            if (i < size) prefix |= static_cast<unsigned char>(data[i]);
+        }
+        return prefix;
+    }
+
+    /** String keys: the nodes cache their normalizedPrefix() (abbreviated keys) */
+    template <>
+    struct KeyPrefix<std::string> {
+        static constexpr bool enabled = true;
+        static std::uint64_t of(const std::string &key) {
+            return normalizedPrefix(key.data(), key.size());
+        }
+    };
+    template <>
+    struct KeyPrefix<std::string_view> {
+        static constexpr bool enabled = true;
+        static std::uint64_t of(std::string_view key) {
+            return normalizedPrefix(key.data(), key.size());
+        }
+    };
+
+    /** Key of a node, in place */
+    template <class T, bool = storeInline<T>::value>
+    struct KeyHolder {
+        T key;
+        explicit KeyHolder(T &&key) : key(std::move(key)) {}
+    };
+
+    /** Key of a node, allocated apart: 'key' refers to it, as an in place one */
+    template <class T>
+    struct KeyHolder<T, false> {
+        T &key;
+        explicit KeyHolder(T &&key) : key(*new T(std::move(key))) {}
+        KeyHolder(const KeyHolder &other) : key(*new T(other.key)) {}
+        ~KeyHolder() { delete &key; }
+        KeyHolder& operator=(const KeyHolder&) = delete;
+    };
+
+    /** Cached KeyPrefix of a node's key, nothing when disabled */
+    template <class T, bool = KeyPrefix<T>::enabled>
+    struct PrefixHolder {
+        explicit PrefixHolder(const T&) {}
+        void setPrefix(const T&) {}
+    };
+    template <class T>
+    struct PrefixHolder<T, true> {
+        std::uint64_t prefix;
+        explicit PrefixHolder(const T &key) : prefix(KeyPrefix<T>::of(key)) {}
+        void setPrefix(const T &key) { prefix = KeyPrefix<T>::of(key); }
+    };
+
     /** Node Base: generic abstract class for specialized Node */
     template <class T, template<typename ...> class N>
-    struct Node {
-        T key;
-        explicit Node(T key) : key(key) {}
+    struct Node : KeyHolder<T>, PrefixHolder<T> {
+        explicit Node(T key) : KeyHolder<T>(std::move(key)), PrefixHolder<T>(this->key) {}
         virtual ~Node() = 0;
+        /** Replace the key (and its cached prefix) */
+        void setKey(T key) {
+            this->key = std::move(key);
+            this->setPrefix(this->key);
+        }
         friend std::ostream& operator<<(std::ostream& os, const N<T>& node) {
             os << node.key; return os;
         }
@@ -74,6 +180,127 @@ namespace base {
     template <class T, template<typename ...> class N>
     Node<T, N>::~Node() {}
 
+    /**
+     * Three-way comparison of a key against a node's: negative, zero or
+     * positive as key is less, equivalent or greater. With a KeyPrefix,
+     * different prefixes (prefix = KeyPrefix<T>::of(key)) decide alone.
+     * */
+    template <class T, class N>
+    inline int compare(const T &key, std::uint64_t prefix, const N &node) {
+        if constexpr (KeyPrefix<T>::enabled) {
+            if (prefix != node.prefix) return prefix < node.prefix ? -1 : 1;
+        } else {
+            (void) prefix;
+        }
+        if (key < node.key) return -1;
+        return node.key < key ? 1 : 0;
+    }
+
+    /** Whether a node layout links every node to its parent (a 'parent' member) */
+    template <class N, class = void>
+    struct hasParent : std::false_type {};
+    template <class N>
+    struct hasParent<N, std::void_t<decltype(std::declval<N&>().parent)>> : std::true_type {};
+
+    /** Whether a node layout keeps its sub-tree height (a 'height' member, as AVLNode) */
+    template <class N, class = void>
+    struct hasHeight : std::false_type {};
+    template <class N>
+    struct hasHeight<N, std::void_t<decltype(std::declval<N&>().height)>> : std::true_type {};
+
+    /** Pair of iterators usable in a range-based for */
+    template <class It>
+    struct Range {
+        It first, last;
+        It begin() const { return first; }
+        It end() const { return last; }
+    };
+
+    /** Hint the CPU to start loading a node's cache line, no-op where unsupported */
+    inline void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void) address;
+#endif
+    }
+
+    /**
+     * Hint the CPU to load the out-of-line data of a key (e.g. the characters
+     * of a std::string) ahead of its use. No-op for keys stored in the node.
+     * */
+    template <class T>
+    inline void prefetchKey(const T &key) { (void) key; }
+    inline void prefetchKey(const std::string &key) { prefetch(key.data()); }
+
+    /**
+     * Stack of trivially copyable elements (node pointers) that keeps the first
+     * Inline elements in place and only goes to the heap past them, so root
+     * paths of balanced trees never allocate. Used by the tree iterators.
+     * */
+    template <class E, std::size_t Inline>
+    class Stack {
+     public:
+        Stack() {}
+        Stack(const Stack& other) { *this = other; }
+        Stack(Stack&& other) { *this = std::move(other); }
+        ~Stack() { if (data != local) delete[] data; }
+        Stack& operator=(const Stack& other);
+        Stack& operator=(Stack&& other);
+        void push_back(E element) {
+            if (count == capacity) reserve(2 * capacity);
+            data[count++] = element;
+        }
+        void pop_back() { --count; }
+        void resize(std::size_t size) { reserve(size); count = size; }  // new elements undefined
+        void reserve(std::size_t size);
+        void clear() { count = 0; }
+        E& back() { return data[count - 1]; }
+        const E& back() const { return data[count - 1]; }
+        E& operator[](std::size_t i) { return data[i]; }
+        const E& operator[](std::size_t i) const { return data[i]; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+     private:
+        E local[Inline];
+        E *data = local;
+        std::size_t count = 0;
+        std::size_t capacity = Inline;
+    };
+
+    template <class E, std::size_t Inline>
+    Stack<E, Inline>& Stack<E, Inline>::operator=(const Stack& other) {
+        if (this != &other) {
+            reserve(other.count);
+            std::copy(other.data, other.data + other.count, data);
+            count = other.count;
+        }
+        return *this;
+    }
+
+    template <class E, std::size_t Inline>
+    Stack<E, Inline>& Stack<E, Inline>::operator=(Stack&& other) {
+        if (this == &other || other.data == other.local) return *this = other;
+        if (data != local) delete[] data;
+        data = other.data;
+        count = other.count;
+        capacity = other.capacity;
+        other.data = other.local;
+        other.count = 0;
+        other.capacity = Inline;
+        return *this;
+    }
+
+    template <class E, std::size_t Inline>
+    void Stack<E, Inline>::reserve(std::size_t size) {
+        if (size <= capacity) return;
+        E *grown = new E[size];
+        std::copy(data, data + count, grown);
+        if (data != local) delete[] data;
+        data = grown;
+        capacity = size;
+    }
+
 
 }  // namespace base
 
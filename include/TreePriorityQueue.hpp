@@ -0,0 +1,237 @@
+/* =========================================================================
+This library is placed under the MIT License
+Copyright 2017 Natanael Josue Rabello. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to
+deal in the Software without restriction, including without limitation the
+rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+ ========================================================================= */
+
+
+/**
+ * @file: TreePriorityQueue.hpp
+ * 
+ * Define a double-ended priority queue adapter on top of the AVLTree.
+ * Equal priorities are allowed (served first in, first out) and every push
+ * returns a handle to its node, whose priority can be changed later by
+ * relinking the same node (no free/alloc), as if pushed again. Pops move the element out
+ * of its node instead of allocating a std::unique_ptr like AVLTree::removeMin().
+ * @see description in AVLTree.hpp
+ * 
+ * @example:
+ * TreePriorityQueue<T> pq;
+ * auto h = pq.push(t1);
+ * pq.push(t2);
+ * pq.updatePriority(h, t3);  // decrease-key (or increase)
+ * const T *t = pq.top();  // ou pq.topMax()
+ * std::optional<T> first = pq.popMin();  // ou pq.popMax()
+ * pq.popK(10, out);  // the 10 lesser elements into out
+ * 
+ * */
+
+#ifndef _TREEPRIORITYQUEUE_HPP_
+#define _TREEPRIORITYQUEUE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include "AVLTree.hpp"
+
+
+/*******************************
+ * Tree Data Structures
+ *******************************/
+namespace trees {
+
+
+namespace base {
+
+    /** Element of a TreePriorityQueue: insertion order breaks the ties between equal priorities */
+    template <class T>
+    struct QueueEntry {
+        T priority;
+        std::uint64_t order;
+        bool operator<(const QueueEntry& o) const {
+            return priority < o.priority || (!(o.priority < priority) && order < o.order);
+        }
+        bool operator>(const QueueEntry& o) const { return o < *this; }
+        bool operator==(const QueueEntry& o) const { return !(*this < o) && !(o < *this); }
+    };
+
+}  // namespace base
+
+
+
+/* ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+ * Double-ended Priority Queue (on AVLTree)
+ * ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^ */
+template <class T>
+class TreePriorityQueue : protected AVLTree<base::QueueEntry<T>> {
+    using Entry = base::QueueEntry<T>;
+    using Base = AVLTree<Entry>;
+    using Node = typename Base::Node;
+
+ public:
+    /** Reference to a pushed element, valid until it is popped or the queue cleared */
+    class Handle {
+     public:
+        Handle() {}
+        const T& priority() const { return node->key.priority; }
+        explicit operator bool() const { return node != nullptr; }
+     private:
+        friend class TreePriorityQueue;
+        explicit Handle(Node *node) : node(node) {}
+        Node *node = nullptr;
+    };
+
+    TreePriorityQueue() : Base() {}
+    TreePriorityQueue(const TreePriorityQueue &other) = default;  // handles stay on other
+    TreePriorityQueue(TreePriorityQueue &&other) noexcept = default;
+    ~TreePriorityQueue() {}
+    TreePriorityQueue& operator=(const TreePriorityQueue &other) = default;
+    TreePriorityQueue& operator=(TreePriorityQueue &&other) noexcept = default;
+
+    /* External Methods */
+    using Base::isEmpty;
+    using Base::size;
+    void clear() override;
+    Handle push(T priority);
+    const T* top() const;
+    const T* topMax() const;
+    std::optional<T> popMin();
+    std::optional<T> popMax();
+    std::size_t popK(std::size_t k, T *out);
+    void updatePriority(Handle handle, T priority);
+
+ protected:
+    using Base::root;
+
+    /* Internal Methods */
+    std::optional<T> pop(bool greatest);
+
+    std::uint64_t pushed = 0;  // insertion order of the next element
+};
+
+
+
+
+
+/**
+ * >> TreePriorityQueue implementation <<
+ * */
+
+/**
+ * Remove all elements, invalidating every handle
+ * */
+template <class T>
+void TreePriorityQueue<T>::clear() {
+    Base::clear();
+}
+
+/**
+ * Insert a element, equal priorities are kept in insertion order
+ * @return a handle to the element, for updatePriority()
+ * */
+template <class T>
+auto TreePriorityQueue<T>::push(T priority) -> Handle {
+    Node *node = new Node(Entry{std::move(priority), pushed++});
+    Base::attach(node);  // never a duplicate: the insertion order is unique
+    return Handle(node);
+}
+
+/**
+ * The lesser element, in O(1)
+ * @return a pointer to the element, or nullptr if the queue is empty
+ * */
+template <class T>
+const T* TreePriorityQueue<T>::top() const {
+    const Entry *entry = Base::getMin();
+    return entry ? &entry->priority : nullptr;
+}
+
+/**
+ * The greater element, in O(1)
+ * @return a pointer to the element, or nullptr if the queue is empty
+ * */
+template <class T>
+const T* TreePriorityQueue<T>::topMax() const {
+    const Entry *entry = Base::getMax();
+    return entry ? &entry->priority : nullptr;
+}
+
+/**
+ * Remove the lesser element (the first pushed among equals)
+ * @return the element, or nothing if the queue is empty
+ * */
+template <class T>
+std::optional<T> TreePriorityQueue<T>::popMin() {
+    return pop(false);
+}
+
+/**
+ * Remove the greater element (the last pushed among equals)
+ * @return the element, or nothing if the queue is empty
+ * */
+template <class T>
+std::optional<T> TreePriorityQueue<T>::popMax() {
+    return pop(true);
+}
+
+/**
+ * Remove up to k lesser elements, in order, into out
+ * @return the number of elements removed
+ * */
+template <class T>
+std::size_t TreePriorityQueue<T>::popK(std::size_t k, T *out) {
+    std::size_t n = 0;
+    for (; n < k && root != nullptr; ++n)
+        out[n] = std::move(*pop(false));
+    return n;
+}
+
+/**
+ * Change the priority of a pushed element: its node is unlinked and linked
+ * again at the new position, so the handle stays valid and nothing is allocated.
+ * It counts as pushed now, served after the elements of equal priority already in.
+ * */
+template <class T>
+void TreePriorityQueue<T>::updatePriority(Handle handle, T priority) {
+    Node *node = Base::detach(handle.node->key);
+    node->key.priority = std::move(priority);
+    node->key.order = pushed++;
+    Base::attach(node);
+}
+
+/**
+ * @see popMin() and popMax()
+ * */
+template <class T>
+std::optional<T> TreePriorityQueue<T>::pop(bool greatest) {
+    Node *node = Base::detachExtreme(greatest);
+    if (node == nullptr) return std::nullopt;
+    std::optional<T> priority(std::move(node->key.priority));
+    delete node;
+    return priority;
+}
+
+
+}  // namespace trees
+
+
+
+#endif  // end of include guard: _TREEPRIORITYQUEUE_HPP_